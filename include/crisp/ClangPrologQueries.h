@@ -36,6 +36,10 @@ namespace crisp {
 
     int plAssertDeclIsA(Decl *Decl, const std::string &Sort);
     int plAssertTypeIsA(Type *Type, const std::string &Sort);
+    int plAssertInstantiationIsA(Decl *Decl, const std::string &Sort);
+    int plNeedsTemplateInstantiations();
+    int plRulesNeedFunctionBodies();
+    int plRulesNeedLLVMIR();
     int plRunTranslationUnitAnalysis(const char* FileName);
 
   } // End namespace crisp::prolog
@@ -0,0 +1,81 @@
+// include/crisp/ContextArena.h --------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+/// \file
+/// \brief Memory for the contexts of nondeterministic foreign
+/// predicates.
+///
+/// Contexts (typically iterators) live between calls to a foreign
+/// predicate, so they can't be on the stack. Allocating them from the
+/// heap costs one \c new and one \c delete per enumeration, which is
+/// significant for predicates called millions of times. An arena
+/// hands out memory from big slabs, recycles released blocks through
+/// per-size free lists, and is reset at once when the Prolog engine
+/// is cleaned up (once per translation unit or LLVM module).
+
+#ifndef CONTEXTARENA_H
+#define CONTEXTARENA_H
+
+#include <cstddef>
+
+#include "llvm/Support/Allocator.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    class ContextArena {
+    public:
+      ContextArena();
+
+      /// Returns a block of at least \c Size bytes, aligned for any
+      /// iterator type.
+      void *allocate(size_t Size);
+
+      /// Makes \c Block, of \c Size bytes, available for later
+      /// allocations of the same size.
+      void deallocate(void *Block, size_t Size);
+
+      /// Releases all the memory at once. Blocks previously allocated
+      /// must not be used any more.
+      void reset();
+
+    private:
+      struct FreeBlock {
+        FreeBlock *Next;
+      };
+
+      /// Blocks are handed out in multiples of \c Granularity bytes.
+      /// Blocks bigger than \c NumSizeClasses * \c Granularity are
+      /// not recycled until reset.
+      static const size_t Granularity = sizeof(void*) * 2;
+      static const unsigned NumSizeClasses = 8;
+
+      llvm::BumpPtrAllocator Allocator;
+      FreeBlock *FreeLists[NumSizeClasses];
+    };
+
+    ContextArena &getContextArena();
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
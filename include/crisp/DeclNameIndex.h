@@ -0,0 +1,79 @@
+// include/crisp/DeclNameIndex.h -------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Per translation unit index from names to declarations.
+
+#ifndef DECLNAMEINDEX_H
+#define DECLNAMEINDEX_H
+
+#include <vector>
+
+#include "clang/AST/Decl.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Maps unqualified and fully qualified names to the named
+    /// declarations visited while traversing the AST. Unqualified
+    /// names are indexed during traversal (no string is built for
+    /// plain identifiers); qualified names are computed the first
+    /// time they are looked up.
+    class DeclNameIndex {
+    public:
+      DeclNameIndex() : NumQualified(0) {}
+
+      /// To be called during AST traversal.
+      void addDecl(const NamedDecl *D);
+
+      llvm::ArrayRef<const NamedDecl*> lookup(StringRef Name) const;
+
+      llvm::ArrayRef<const NamedDecl*> lookupQualified(StringRef Name);
+
+      /// All indexed declarations, in traversal order.
+      llvm::ArrayRef<const NamedDecl*> decls() const {
+        return Decls;
+      }
+
+    private:
+      typedef llvm::SmallVector<const NamedDecl*, 1> DeclList;
+
+      std::vector<const NamedDecl*> Decls;
+      llvm::StringMap<DeclList> Names;
+      llvm::StringMap<DeclList> QualifiedNames;
+      unsigned NumQualified;    // Prefix of Decls in QualifiedNames
+    };
+
+    DeclNameIndex* getDeclNameIndex();
+
+    void newDeclNameIndex();
+
+    void deleteDeclNameIndex();
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
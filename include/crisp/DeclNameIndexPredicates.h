@@ -0,0 +1,57 @@
+/* include/crisp/DeclNameIndexPredicates.h --------------------------*- C -*- */
+
+/* Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+
+   This file is part of Crisp.
+
+   Crisp is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Crisp is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ *  \brief Predicates to look up declarations by name, shared by the
+ *  Crisp Clang plugin and the declaration extractor.
+ */
+
+#ifndef DECLNAMEINDEXPREDICATES_H
+#define DECLNAMEINDEXPREDICATES_H
+
+#include <SWI-Prolog.h>
+
+#ifdef __cplusplus
+extern "C" {
+  namespace crisp {
+
+    namespace prolog {
+#endif
+
+      /** \param NameT +Atom, an unqualified name
+       *  \param DeclT NamedDecl
+       */
+      foreign_t pl_declByName(term_t NameT, term_t DeclT, control_t Handle);
+
+      /** \param NameT +Atom, a fully qualified name (e.g. 'clang::Decl')
+       *  \param DeclT NamedDecl
+       */
+      foreign_t pl_declByQualifiedName(term_t NameT, term_t DeclT,
+                                       control_t Handle);
+
+#ifdef __cplusplus
+    } /* End namespace crisp::prolog */
+
+  }   /* End namespace crisp  */
+
+} /* End "extern" C */
+#endif
+
+#endif  /* #ifndef DECLNAMEINDEXPREDICATES_H */
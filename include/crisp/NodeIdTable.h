@@ -0,0 +1,115 @@
+// include/crisp/NodeIdTable.h ---------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Representation of LLVM/Clang objects as Prolog terms.
+///
+/// By default objects are passed to Prolog as raw pointers. In \e ID
+/// mode every object gets instead a dense 32-bit identifier, assigned
+/// the first time the object is seen, and a side table maps
+/// identifiers back to pointers. Identifiers fit in SWI-Prolog tagged
+/// small integers and are stable across runs on the same input,
+/// provided objects are visited in the same order.
+
+#ifndef NODEIDTABLE_H
+#define NODEIDTABLE_H
+
+#include <vector>
+#include <SWI-Prolog.h>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/DataTypes.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    class NodeIdTable {
+    public:
+      NodeIdTable() : Enabled(false), Nodes(1, (void *) 0) {}
+
+      bool isEnabled() const { return Enabled; }
+
+      void setEnabled(bool E) { Enabled = E; }
+
+      /// Returns the identifier of \c Node, assigning a new one if \c
+      /// Node hasn't been seen before. Identifier 0 is reserved for
+      /// null pointers.
+      uint32_t getId(const void *Node);
+
+      /// Returns the object with identifier \c Id, or null if \c Id
+      /// has not been assigned.
+      void *getNode(int64_t Id) const {
+        if (Id <= 0 || (uint64_t) Id >= Nodes.size()) return 0;
+        return Nodes[Id];
+      }
+
+      /// Forgets all assigned identifiers. Called once per
+      /// translation unit (or LLVM module).
+      void clear();
+
+    private:
+      bool Enabled;
+      llvm::DenseMap<const void*, uint32_t> Ids;
+      std::vector<void*> Nodes;
+    };
+
+    NodeIdTable &getNodeIdTable();
+
+    /// Replacement for \c PL_get_pointer aware of ID mode.
+    inline int plGetNode(term_t NodeT, void **Node) {
+      NodeIdTable &NIT = getNodeIdTable();
+      if ( !NIT.isEnabled()) return PL_get_pointer(NodeT, Node);
+      int64_t Id;
+      if ( !PL_get_int64(NodeT, &Id)) return FALSE;
+      *Node = NIT.getNode(Id);
+      return *Node ? TRUE : FALSE;
+    }
+
+    /// Replacement for \c PL_unify_pointer aware of ID mode.
+    inline int plUnifyNode(term_t NodeT, const void *Node) {
+      NodeIdTable &NIT = getNodeIdTable();
+      if ( !NIT.isEnabled()) return PL_unify_pointer(NodeT, (void *) Node);
+      return PL_unify_int64(NodeT, (int64_t) NIT.getId(Node));
+    }
+
+    /// Unifies \c NodeT with an object that doesn't outlive the call
+    /// that produces it (a by-value result, or an element stored in an
+    /// iterator): giving it an identifier would map the same address
+    /// to unrelated objects, and leave dangling pointers in the table.
+    /// In ID mode it is unified with a negative integer, that \c
+    /// plGetNode never takes for an identifier.
+    inline int plUnifyTransientNode(term_t NodeT, const void *Node) {
+      if ( !getNodeIdTable().isEnabled())
+        return PL_unify_pointer(NodeT, (void *) Node);
+      return PL_unify_int64(NodeT, - (int64_t) (intptr_t) Node);
+    }
+
+    /// Replacement for \c PL_put_pointer aware of ID mode.
+    inline int plPutNode(term_t NodeT, const void *Node) {
+      NodeIdTable &NIT = getNodeIdTable();
+      if ( !NIT.isEnabled()) return PL_put_pointer(NodeT, (void *) Node);
+      return PL_put_int64(NodeT, (int64_t) NIT.getId(Node));
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
@@ -0,0 +1,163 @@
+// include/crisp/PredicateTable.h ------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Registration of generated predicates from descriptor tables.
+///
+/// By default every generated predicate is a separate function, an
+/// instantiation of \c getOne, \c checkProperty, etc. with its own
+/// member pointer, and it is registered on its own. When \c
+/// CRISP_PREDICATE_TABLES is defined, predicates are instead
+/// registered from static tables. Getters and property checkers hold
+/// their (type-erased) member function pointer in a constant \c
+/// ErasedGetter, and share a few dispatchers, one per argument and
+/// result type. Every one of them only adds a trampoline, with
+/// internal linkage, that calls its dispatcher with its getter.
+
+#ifndef PREDICATETABLE_H
+#define PREDICATETABLE_H
+
+#include <SWI-Prolog.h>
+
+#include "crisp/PrologPredBaseTemplates.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Member function pointers of any class are stored as pointers
+    /// to members of this one, and cast back by dispatchers.
+    class ErasedClass;
+    typedef void (ErasedClass::* ErasedMethod)();
+
+    struct PredicateDescriptor {
+      const char *Name;
+      int Arity;
+      pl_function_t Function;
+      int Flags;
+    };
+
+    /// A getter or property checker known only at run time, and the
+    /// name of its predicate (for warnings).
+    struct ErasedGetter {
+      const char *Name;
+      ErasedMethod Method;
+    };
+
+    /// Registers all the rows of \c Table, that ends with a row with
+    /// a null \c Name.
+    int plRegisterPredicateTable(const PredicateDescriptor *Table);
+
+    /// When generated predicates are compiled in several shards (see
+    /// \c CRISP_DECL_SHARDS), every shard defines its own table and a
+    /// static \c PredicateTableLink for it. Linked tables are
+    /// registered together by \c plRegisterLinkedPredicateTables().
+    class PredicateTableLink {
+    public:
+      explicit PredicateTableLink(const PredicateDescriptor *Table);
+
+    private:
+      friend int plRegisterLinkedPredicateTables();
+
+      const PredicateDescriptor *Table;
+      const PredicateTableLink *Next;
+    };
+
+    int plRegisterLinkedPredicateTables();
+
+    /// Version of \c Get for a getter known only at run time.
+    template <class ArgumentType,
+              typename ResultType>
+    struct GetErased {
+      typedef const ArgumentType* argument_type;
+      typedef ResultType (ArgumentType::* getter_type)() const;
+      static inline ResultType _(argument_type A, getter_type Getter) {
+        if ( !A) return ResultType();
+        return (A ->* Getter)();
+      }
+    };
+
+    /// Version of \c Check for a property known only at run time.
+    template <class ArgumentType>
+    struct CheckErased {
+      typedef const ArgumentType* argument_type;
+      typedef bool (ArgumentType::* predicate_type)() const;
+      static inline foreign_t _(argument_type A, predicate_type Predicate) {
+        if ( !A) return FALSE;
+        return (A ->* Predicate)() ? TRUE : FALSE;
+      }
+    };
+
+    /// Shared dispatcher for \c getOne() predicates.
+    template <typename ArgumentType,
+              typename ResultType,
+              typename UnifyPolicy>
+    foreign_t dispatchGetOne(term_t ArgumentT, term_t ResultT,
+                             const ErasedGetter &G) {
+      typedef GetErased<ArgumentType, ResultType> GetPolicy;
+      typename Retrieve<ArgumentType>::argument_type Argument;
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Argument, G.Name))
+        return FALSE;
+      return UnifyPolicy::_(ResultT, GetPolicy::_
+                            (Argument, reinterpret_cast
+                             <typename GetPolicy::getter_type>(G.Method)));
+    }
+
+    /// Shared dispatcher for \c getOneCached() predicates. The
+    /// address of \c G identifies the getter in the \c ResultCache.
+    template <typename ArgumentType,
+              typename ResultType,
+              typename UnifyPolicy>
+    foreign_t dispatchGetOneCached(term_t ArgumentT, term_t ResultT,
+                                   const ErasedGetter &G) {
+      void *Node;
+      if ( !plGetNode(ArgumentT, &Node))
+        return pl_warning(Twine(G.Name)
+                          + ": instantiation fault on first arg");
+      record_t Cached;
+      if (getResultCache().lookup(Node, &G, Cached))
+        return unifyCachedResult(ResultT, Cached);
+      typedef GetErased<ArgumentType, ResultType> GetPolicy;
+      typename Retrieve<ArgumentType>::argument_type Argument;
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Argument, G.Name))
+        return FALSE;
+      term_t CachedT = PL_new_term_ref();
+      return cacheResult(Node, &G, ResultT, CachedT, UnifyPolicy::_
+                         (CachedT, GetPolicy::_
+                          (Argument, reinterpret_cast
+                           <typename GetPolicy::getter_type>(G.Method))));
+    }
+
+    /// Shared dispatcher for \c checkProperty() predicates.
+    template <typename ArgumentType>
+    foreign_t dispatchCheckProperty(term_t ArgumentT, const ErasedGetter &G) {
+      typedef CheckErased<ArgumentType> CheckPolicy;
+      typename Retrieve<ArgumentType>::argument_type Argument;
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Argument, G.Name))
+        return FALSE;
+      return CheckPolicy::_(Argument, reinterpret_cast
+                            <typename CheckPolicy::predicate_type>
+                            (G.Method));
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
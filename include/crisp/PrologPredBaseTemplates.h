@@ -23,14 +23,22 @@
 #ifndef PROLOGPREDBASETEMPLATES_H
 #define PROLOGPREDBASETEMPLATES_H
 
+#include <cstring>
 #include <iterator>
+#include <new>
 #include <string>
 #include <SWI-Prolog.h>
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/ilist.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Use.h"
 
+#include "crisp/ContextArena.h"
+#include "crisp/NodeIdTable.h"
+#include "crisp/PrologUtilityFunctions.h"
+#include "crisp/ResultCache.h"
+
 using namespace llvm;
 
 namespace crisp {
@@ -40,7 +48,7 @@ namespace crisp {
     /// This function is used to concat different \c string's (or \c
     /// const \c char*, or \c StringRef's) in one single Prolog
     /// warning message.
-    foreign_t pl_warning(const Twine &Message) {
+    inline foreign_t pl_warning(const Twine &Message) {
       return PL_warning(Message.getSingleStringRef().data());
     }
 
@@ -52,7 +60,7 @@ namespace crisp {
 
       static inline int
       _(term_t ArgumentT, argument_type* A, StringRef PredName) {
-        if ( !PL_get_pointer(ArgumentT, (void **) A))
+        if ( !plGetNode(ArgumentT, (void **) A))
           return pl_warning(PredName + ": instantiation fault on first arg");
         return TRUE;
       }
@@ -81,7 +89,7 @@ namespace crisp {
     struct Unify {
       typedef ResultType result_type;
       static inline foreign_t _(term_t ResultT, result_type Result) {
-        return PL_unify_pointer(ResultT, &Result);
+        return plUnifyTransientNode(ResultT, &Result);
       }
     };
 
@@ -91,7 +99,7 @@ namespace crisp {
       typedef ResultType* result_type;
       static inline foreign_t _(term_t ResultT, result_type Result) {
         if ( !Result) return FALSE;
-        return PL_unify_pointer(ResultT, Result);
+        return plUnifyNode(ResultT, Result);
       }
     };
 
@@ -101,7 +109,7 @@ namespace crisp {
       typedef const ResultType* result_type;
       static inline foreign_t _(term_t ResultT, result_type Result) {
         if ( !Result) return FALSE;
-        return PL_unify_pointer(ResultT, (void *) Result); // Cast removes const
+        return plUnifyNode(ResultT, (void *) Result); // Cast removes const
       }
     };
 
@@ -110,7 +118,7 @@ namespace crisp {
     struct Unify<ResultType&> {
       typedef ResultType& result_type;
       static inline foreign_t _(term_t ResultT, result_type Result) {
-        return PL_unify_pointer(ResultT, &Result);
+        return plUnifyNode(ResultT, &Result);
       }
     };
 
@@ -119,7 +127,7 @@ namespace crisp {
     struct Unify<const ResultType&> {
       typedef const ResultType& result_type;
       static inline foreign_t _(term_t ResultT, result_type Result) {
-        return PL_unify_pointer(ResultT, (void *) &Result); // Cast rem. const
+        return plUnifyNode(ResultT, (void *) &Result); // Cast rem. const
       }
     };
 
@@ -128,16 +136,17 @@ namespace crisp {
     struct Unify<std::string> {
       typedef std::string result_type;
       static inline foreign_t _(term_t ResultT, const result_type& Result) {
-        return PL_unify_atom_chars(ResultT, Result.c_str());
+        return PL_unify_atom_nchars(ResultT, Result.size(), Result.data());
       }
     };
 
-    /// Specialization for \c llvm::StringRef.
+    /// Specialization for \c llvm::StringRef. Characters are passed
+    /// with their length, so no null-terminated copy is needed.
     template <>
     struct Unify<llvm::StringRef> {
       typedef llvm::StringRef result_type;
       static inline foreign_t _(term_t ResultT, const result_type Result) {
-        return PL_unify_atom_chars(ResultT, Result.str().c_str());
+        return PL_unify_atom_nchars(ResultT, Result.size(), Result.data());
       }
     };
 
@@ -151,6 +160,33 @@ namespace crisp {
       }
     };
 
+    /// Unification policy for one-shot text results: an atom, or a
+    /// string if \c plStringResults() is set.
+    template <typename ResultType>
+    struct UnifyText;
+
+    /// Specialization for \c std::string.
+    template <>
+    struct UnifyText<std::string> {
+      typedef std::string result_type;
+      static inline foreign_t _(term_t ResultT, const result_type& Result) {
+        return PL_unify_chars(ResultT,
+                              plStringResults() ? PL_STRING : PL_ATOM,
+                              Result.size(), Result.data());
+      }
+    };
+
+    /// Specialization for \c llvm::StringRef.
+    template <>
+    struct UnifyText<llvm::StringRef> {
+      typedef llvm::StringRef result_type;
+      static inline foreign_t _(term_t ResultT, const result_type Result) {
+        return PL_unify_chars(ResultT,
+                              plStringResults() ? PL_STRING : PL_ATOM,
+                              Result.size(), Result.data());
+      }
+    };
+
     /// Specialization for \c unsigned.
     template <>
     struct Unify<unsigned> {
@@ -177,6 +213,138 @@ namespace crisp {
       return Unify<ResultType>::_(ResultT, Result);
     }
 
+    /// General templarized function to define a ternary Prolog
+    /// predicate that given an individual (\c ArgumentT) and a
+    /// position (\c IndexT) unifies \c ResultT with the individual
+    /// returned by an indexed accessor (\c Getter), in constant
+    /// time. Positions are checked against \c Size. If \c IndexT is
+    /// free, all the positions are enumerated in order.
+    template <typename ArgumentType,
+              typename ResultType,
+              typename IndexType,
+              ResultType (ArgumentType::* Getter)(IndexType) const,
+              typename SizeType,
+              SizeType (ArgumentType::* Size)() const>
+    foreign_t getOneN(term_t ArgumentT, term_t IndexT, term_t ResultT,
+                      StringRef GetterName, control_t Handle) {
+      int64_t I = 0;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        break;
+      case PL_REDO:
+        I = PL_foreign_context(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+      typename Retrieve<ArgumentType>::argument_type Argument;
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Argument, GetterName))
+        return FALSE;
+      if ( !Argument) return FALSE;
+      int64_t N = (int64_t) (Argument ->* Size)();
+
+      if (PL_foreign_control(Handle) == PL_FIRST_CALL
+          && !PL_is_variable(IndexT)) {       // Positional access
+        if ( !PL_get_int64(IndexT, &I))
+          return pl_warning(GetterName + ": type error on second arg");
+        if (I < 0 || I >= N) return FALSE;
+        return Unify<ResultType>::_(ResultT,
+                                    (Argument ->* Getter)((IndexType) I));
+      }
+
+      for (; I < N; ++I) {
+        if ( !Unify<ResultType>::_(ResultT,
+                                   (Argument ->* Getter)((IndexType) I)))
+          continue;
+        if ( !PL_unify_int64(IndexT, I)) return FALSE;
+        if (I + 1 == N) return TRUE;
+        PL_retry(I + 1);
+      }
+      return FALSE;
+    }
+
+    /// Gives every cached getter an address of its own, used (along
+    /// with the node) as key in the \c ResultCache.
+    template <typename ArgumentType,
+              typename ResultType,
+              ResultType (ArgumentType::* Getter)() const>
+    struct CachedGetter {
+      static const char Id;
+    };
+
+    template <typename ArgumentType,
+              typename ResultType,
+              ResultType (ArgumentType::* Getter)() const>
+    const char CachedGetter<ArgumentType, ResultType, Getter>::Id = 0;
+
+    /// Unifies \c ResultT with a result previously cached by \c
+    /// cacheResult().
+    inline foreign_t unifyCachedResult(term_t ResultT, record_t Result) {
+      if ( !Result) return FALSE;  // Known failure
+      term_t CachedT = PL_new_term_ref();
+      if ( !PL_recorded(Result, CachedT)) return FALSE;
+      return PL_unify(ResultT, CachedT);
+    }
+
+    /// Caches the (just computed) result in \c CachedT, or a failure
+    /// if \c Success is false, and unifies it with \c ResultT.
+    inline foreign_t cacheResult(const void *Node, const void *Getter,
+                                 term_t ResultT, term_t CachedT,
+                                 foreign_t Success) {
+      getResultCache().insert(Node, Getter, Success ? CachedT : 0);
+      if ( !Success) return FALSE;
+      return PL_unify(ResultT, CachedT);
+    }
+
+    /// Version of \c getOne() for expensive getters. The result for
+    /// every node is computed (and converted to a term with \c
+    /// UnifyPolicy) only once per translation unit.
+    template <typename ArgumentType,
+              typename ResultType,
+              ResultType (ArgumentType::* Getter)() const,
+              typename UnifyPolicy>
+    foreign_t getOneCachedWith(term_t ArgumentT, term_t ResultT,
+                               StringRef GetterName) {
+      const void *GetterId
+        = &CachedGetter<ArgumentType, ResultType, Getter>::Id;
+      void *Node;
+      if ( !plGetNode(ArgumentT, &Node))
+        return pl_warning(GetterName + ": instantiation fault on first arg");
+      record_t Cached;
+      if (getResultCache().lookup(Node, GetterId, Cached))
+        return unifyCachedResult(ResultT, Cached);
+      typename Retrieve<ArgumentType>::argument_type Argument;
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Argument, GetterName))
+        return FALSE;
+      typename Get<ArgumentType, ResultType, Getter>::result_type Result
+        = Get<ArgumentType, ResultType, Getter>::_(Argument);
+      term_t CachedT = PL_new_term_ref();
+      return cacheResult(Node, GetterId, ResultT, CachedT,
+                         UnifyPolicy::_(CachedT, Result));
+    }
+
+    template <typename ArgumentType,
+              typename ResultType,
+              ResultType (ArgumentType::* Getter)() const>
+    foreign_t getOneCached(term_t ArgumentT, term_t ResultT,
+                           StringRef GetterName) {
+      return getOneCachedWith<ArgumentType, ResultType, Getter,
+                              Unify<ResultType> >
+        (ArgumentT, ResultT, GetterName);
+    }
+
+    /// Version of \c getOneCached() for one-shot text results (see
+    /// \c UnifyText).
+    template <typename ArgumentType,
+              typename ResultType,
+              ResultType (ArgumentType::* Getter)() const>
+    foreign_t getOneText(term_t ArgumentT, term_t ResultT,
+                         StringRef GetterName) {
+      return getOneCachedWith<ArgumentType, ResultType, Getter,
+                              UnifyText<ResultType> >
+        (ArgumentT, ResultT, GetterName);
+    }
+
     /// Most general template. In fact it assumes that \c ArgumentType
     /// is a pointer type.
     template <typename ArgumentType,
@@ -218,13 +386,29 @@ namespace crisp {
       return Check<ArgumentType, Getter>::_(Argument);
     }
 
+    /// Tells whether the element an iterator points to outlives the
+    /// iterator. Most general template: the element can be stored in
+    /// the iterator itself.
+    template <typename IteratorType>
+    struct IteratorElementPersists {
+      static const bool value = false;
+    };
+
+    /// Specialization for pointers, that point into the container.
+    template <typename ElementType>
+    struct IteratorElementPersists<ElementType*> {
+      static const bool value = true;
+    };
+
     /// Most general template.
     template <typename IteratorType,
               typename UnifyType>
     struct UnifyIteratorAux {
       typedef IteratorType iterator_type;
       static inline foreign_t _(term_t ResultT, iterator_type I) {
-        return PL_unify_pointer(ResultT, (void *) &*I);
+        if (IteratorElementPersists<iterator_type>::value)
+          return plUnifyNode(ResultT, (void *) &*I);
+        return plUnifyTransientNode(ResultT, &*I);
       }
     };
 
@@ -234,7 +418,8 @@ namespace crisp {
     struct UnifyIteratorAux<IteratorType, UnifyType*> {
       typedef IteratorType iterator_type;
       static inline foreign_t _(term_t ResultT, iterator_type I) {
-        return PL_unify_pointer(ResultT, (void *) *I);
+        if ( !*I) return FALSE;
+        return plUnifyNode(ResultT, (void *) *I);
       }
     };
 
@@ -244,7 +429,8 @@ namespace crisp {
     struct UnifyIteratorAux<IteratorType, Use> {
       typedef IteratorType iterator_type;
       static inline foreign_t _(term_t ResultT, iterator_type I) {
-        return PL_unify_pointer(ResultT, (Value *) *I);
+        if ( !(Value *) *I) return FALSE;
+        return plUnifyNode(ResultT, (Value *) *I);
       }
     };
 
@@ -279,7 +465,7 @@ namespace crisp {
       typedef typename traits_type::pointer unify_type;
       static inline foreign_t _(term_t ResultT, iterator_type I) {
         if ( !((unify_type) I)) return FALSE;
-        return PL_unify_pointer(ResultT, (void *) (unify_type) I);
+        return plUnifyNode(ResultT, (void *) (unify_type) I);
       }
     };
 
@@ -330,17 +516,21 @@ namespace crisp {
     /// Most general version for template class \c Context. It doesn't
     /// assume any specific property about the iterator type used, so
     /// it takes the most general policy to store context information:
-    /// use the heap. More specific and efficient storing policies
-    /// should be used whenever possible.
+    /// a copy of the iterator out of the stack, in the context arena
+    /// (see ContextArena.h) to avoid general-purpose heap
+    /// allocation. More specific and efficient storing policies should
+    /// be used whenever possible.
     template <typename IteratorType>
     struct Context {
       typedef IteratorType iterator_type;
       typedef IteratorType* context_type;
       static inline context_type newContext(iterator_type I) {
-        return new iterator_type(I);
+        void *Block = getContextArena().allocate(sizeof(iterator_type));
+        return new (Block) iterator_type(I);
       }
       static inline void deleteContext(context_type C) {
-        delete C;
+        C->~iterator_type();
+        getContextArena().deallocate(C, sizeof(iterator_type));
       }
       static inline void context2iter(context_type C, iterator_type& I) {
         I = *C;
@@ -350,6 +540,39 @@ namespace crisp {
       }
     };
 
+    /// Policy to store the iterator itself as context, for iterators
+    /// that are just a pointer to objects aligned to at least 4 bytes
+    /// (SWI-Prolog uses the 2 lowest bits of context addresses), and
+    /// can be copied bitwise. Specializations of \c Context for such
+    /// iterators should inherit from it.
+    template <typename IteratorType>
+    struct InPlaceContext {
+      typedef IteratorType iterator_type;
+      typedef void* context_type;
+      static inline context_type newContext(iterator_type I) {
+        // Fails to compile if iterator_type doesn't fit in a pointer
+        (void) sizeof(char[sizeof(iterator_type) <= sizeof(void*) ? 1 : -1]);
+        context_type C = 0;
+        std::memcpy(&C, &I, sizeof(iterator_type));
+        return C;
+      }
+      static inline void deleteContext(context_type C) {
+        // Do nothing.
+      }
+      static inline void context2iter(context_type C, iterator_type& I) {
+        std::memcpy(&I, &C, sizeof(iterator_type));
+      }
+      static inline void iter2context(iterator_type I, context_type& C) {
+        std::memcpy(&C, &I, sizeof(iterator_type));
+      }
+    };
+
+    /// Specialization for \c llvm::value_use_iterator 's, that are
+    /// just a pointer to a \c Use.
+    template <typename UserType>
+    struct Context< value_use_iterator<UserType> >
+      : InPlaceContext< value_use_iterator<UserType> > {};
+
     /// Specialization for \c ilist_iterator 's. As class \c
     /// ilist_iterator is in fact a smart pointer, we don't need
     /// dynamic memory allocation in this case.
@@ -396,6 +619,11 @@ namespace crisp {
     /// name (\c IteratorType) non-deterministically unifies \c
     /// ResultT with all the individuals related with \c ArgumentT
     /// through this role.
+    ///
+    /// The context saved between calls is an iterator to the next
+    /// element, so that no choice point is left after the last
+    /// solution. If \c ResultT is bound on call the predicate is a
+    /// deterministic membership test.
     template <typename ArgumentType,
               typename IteratorHelper>
     foreign_t getManyAux(term_t ArgumentT, term_t ResultT, StringRef PredName,
@@ -403,49 +631,52 @@ namespace crisp {
       typedef typename IteratorHelper::iterator_type iterator_type;
       typedef typename Context<iterator_type>::context_type context_type;
       iterator_type It;
-      context_type Ctxt;
+      context_type Ctxt = 0;
       typename Retrieve<ArgumentType>::argument_type Container;
 
       switch (PL_foreign_control(Handle)) {
-      case PL_FIRST_CALL: case PL_REDO:       // Get Container
-        if ( !Retrieve<ArgumentType>::_(ArgumentT, &Container, PredName))
-          return FALSE;
-      }
-
-      switch (PL_foreign_control(Handle)) {
-      case PL_FIRST_CALL:                     // Get first elem
-        It = IteratorHelper::begin(Container);
-        break;
-      case PL_REDO:                           // Get next elem
+      case PL_PRUNED:                         // Clean context
         Ctxt = (context_type) PL_foreign_context_address(Handle);
-        Context<iterator_type>::context2iter(Ctxt, It);
-        It++;
-        break;
-      case PL_PRUNED:
+        Context<iterator_type>::deleteContext(Ctxt);
+        return TRUE;
+      case PL_REDO:                           // Get saved next elem
         Ctxt = (context_type) PL_foreign_context_address(Handle);
+        Context<iterator_type>::context2iter(Ctxt, It);
       }
 
-      switch (PL_foreign_control(Handle)) {   // Return if It ended
-      case PL_FIRST_CALL: case PL_REDO:
-        if (It == IteratorHelper::end(Container)) return FALSE;
+      // Get Container
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Container, PredName)) {
+        if (Ctxt) Context<iterator_type>::deleteContext(Ctxt);
+        return FALSE;
       }
+      iterator_type End = IteratorHelper::end(Container);
 
-      switch (PL_foreign_control(Handle)) {   // Save It for next calls
-      case PL_FIRST_CALL:
-        Ctxt = Context<iterator_type>::newContext(It);
-      case PL_REDO:
-        Context<iterator_type>::iter2context(It, Ctxt);
+      if (PL_foreign_control(Handle) == PL_FIRST_CALL) {
+        It = IteratorHelper::begin(Container);
+        if ( !PL_is_variable(ResultT)) {      // Membership test
+          for (; It != End; ++It)
+            if (UnifyIterator<iterator_type>::_(ResultT, It)) return TRUE;
+          return FALSE;
+        }
       }
 
-      switch (PL_foreign_control(Handle)) {
-      case PL_FIRST_CALL: case PL_REDO:       // Return first/next
-        (void) UnifyIterator<iterator_type>::_(ResultT, It);
-        PL_retry_address((void *) Ctxt);      // Returns. Cast remove constness
-      case PL_PRUNED:                         // Clean context
-        Context<iterator_type>::deleteContext(Ctxt);
-      default:
+      // Return first/next (unification only fails for null elements)
+      while (It != End && !UnifyIterator<iterator_type>::_(ResultT, It))
+        ++It;
+      if (It == End) {
+        if (Ctxt) Context<iterator_type>::deleteContext(Ctxt);
+        return FALSE;
+      }
+      ++It;
+      if (It == End) {                        // Last elem: deterministic
+        if (Ctxt) Context<iterator_type>::deleteContext(Ctxt);
         return TRUE;
       }
+
+      // Save next elem for next call
+      if ( !Ctxt) Ctxt = Context<iterator_type>::newContext(It);
+      else Context<iterator_type>::iter2context(It, Ctxt);
+      PL_retry_address((void *) Ctxt);        // Returns. Cast remove constness
     }
 
     /// Overloaded function template. Version for begin/end member
@@ -476,6 +707,249 @@ namespace crisp {
         (ArgumentT, ResultT, PredName, Handle);
     }
 
+    /// Version of \c getManyAux() that can also be called with \c
+    /// ArgumentT free and \c ResultT bound. Then \c Inverse gives
+    /// the only candidate container of the individual in \c ResultT,
+    /// that is checked (deterministically) like in the (+,+) mode.
+    template <typename ArgumentType,
+              typename IteratorHelper,
+              const void *(* Inverse)(const void*)>
+    foreign_t getManyReversibleAux(term_t ArgumentT, term_t ResultT,
+                                   StringRef PredName, control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_FIRST_CALL
+          && PL_is_variable(ArgumentT) && !PL_is_variable(ResultT)) {
+        void *Result;
+        if ( !plGetNode(ResultT, &Result)) return FALSE;
+        const void *Container = Inverse(Result);
+        if ( !Container || !plUnifyNode(ArgumentT, Container)) return FALSE;
+      }
+      return getManyAux<ArgumentType, IteratorHelper>
+        (ArgumentT, ResultT, PredName, Handle);
+    }
+
+    /// Overloaded function template. Version for begin/end member
+    /// functions.
+    template <typename ArgumentType,
+              typename IteratorType,
+              IteratorType (ArgumentType::* Begin)() const,
+              IteratorType (ArgumentType::* End)() const,
+              const void *(* Inverse)(const void*)>
+    foreign_t getManyReversible(term_t ArgumentT, term_t ResultT,
+                                StringRef PredName, control_t Handle) {
+      typedef MemberIteratorHelper<ArgumentType, IteratorType, Begin, End>
+        IteratorHelper;
+      return getManyReversibleAux<ArgumentType, IteratorHelper, Inverse>
+        (ArgumentT, ResultT, PredName, Handle);
+    }
+
+    /// Overloaded function template. Version for begin/end ordinary
+    /// functions.
+    template <typename ArgumentType,
+              typename IteratorType,
+              IteratorType (* Begin)(const ArgumentType*),
+              IteratorType (* End)(const ArgumentType*),
+              const void *(* Inverse)(const void*)>
+    foreign_t getManyReversible(term_t ArgumentT, term_t ResultT,
+                                StringRef PredName, control_t Handle) {
+      typedef ExternalIteratorHelper<ArgumentType, IteratorType, Begin, End>
+        IteratorHelper;
+      return getManyReversibleAux<ArgumentType, IteratorHelper, Inverse>
+        (ArgumentT, ResultT, PredName, Handle);
+    }
+
+    /// General templarized function to define a binary Prolog
+    /// predicate that given an individual (\c ArgumentT) and a role
+    /// name (\c IteratorType) unifies \c ListT with the list of all
+    /// the (non-null) individuals related with \c ArgumentT through
+    /// this role, in a single call.
+    template <typename ArgumentType,
+              typename IteratorHelper>
+    foreign_t getListAux(term_t ArgumentT, term_t ListT, StringRef PredName) {
+      typedef typename IteratorHelper::iterator_type iterator_type;
+      typename Retrieve<ArgumentType>::argument_type Container;
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Container, PredName))
+        return FALSE;
+      term_t TailT = PL_copy_term_ref(ListT);
+      term_t HeadT = PL_new_term_ref();
+      term_t ElemT = PL_new_term_ref();
+      iterator_type End = IteratorHelper::end(Container);
+      for (iterator_type It = IteratorHelper::begin(Container); It != End;
+           ++It) {
+        PL_put_variable(ElemT);
+        if ( !UnifyIterator<iterator_type>::_(ElemT, It)) continue; // Null
+        if ( !PL_unify_list(TailT, HeadT, TailT) || !PL_unify(HeadT, ElemT))
+          return FALSE;
+      }
+      return PL_unify_nil(TailT);
+    }
+
+    /// General templarized function to define a binary Prolog
+    /// predicate that given an individual (\c ArgumentT) and a role
+    /// name (\c IteratorType) unifies \c CountT with the number of
+    /// (non-null) elements in the range, i.e. the length of the list
+    /// given by \c getListAux().
+    template <typename ArgumentType,
+              typename IteratorHelper>
+    foreign_t getCountAux(term_t ArgumentT, term_t CountT,
+                          StringRef PredName) {
+      typedef typename IteratorHelper::iterator_type iterator_type;
+      typename Retrieve<ArgumentType>::argument_type Container;
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Container, PredName))
+        return FALSE;
+      int64_t Count = 0;
+      term_t ElemT = PL_new_term_ref();
+      fid_t Frame = PL_open_foreign_frame();
+      iterator_type End = IteratorHelper::end(Container);
+      for (iterator_type It = IteratorHelper::begin(Container); It != End;
+           ++It) {
+        if (UnifyIterator<iterator_type>::_(ElemT, It)) ++Count; // Not null
+        PL_rewind_foreign_frame(Frame);
+      }
+      PL_close_foreign_frame(Frame);
+      return PL_unify_int64(CountT, Count);
+    }
+
+    /// Tells whether elements of type \c ElementType can be null, and
+    /// thus skipped in enumerations. Most general template.
+    template <typename ElementType>
+    struct ElementMayBeNull {
+      static const bool value = false;
+    };
+
+    /// Specialization for pointers.
+    template <typename ElementType>
+    struct ElementMayBeNull<ElementType*> {
+      static const bool value = true;
+    };
+
+    /// Specialization for llvm::Use (kind of smart pointer to a
+    /// Value*).
+    template <>
+    struct ElementMayBeNull<Use> {
+      static const bool value = true;
+    };
+
+    /// Overloaded function template. Version for begin/end member
+    /// functions.
+    template <typename ArgumentType,
+              typename IteratorType,
+              IteratorType (ArgumentType::* Begin)() const,
+              IteratorType (ArgumentType::* End)() const>
+    foreign_t getList(term_t ArgumentT, term_t ListT, StringRef PredName) {
+      typedef MemberIteratorHelper<ArgumentType, IteratorType, Begin, End>
+        IteratorHelper;
+      return getListAux<ArgumentType, IteratorHelper>
+        (ArgumentT, ListT, PredName);
+    }
+
+    /// Overloaded function template. Version for begin/end ordinary
+    /// functions.
+    template <typename ArgumentType,
+              typename IteratorType,
+              IteratorType (* Begin)(const ArgumentType*),
+              IteratorType (* End)(const ArgumentType*)>
+    foreign_t getList(term_t ArgumentT, term_t ListT, StringRef PredName) {
+      typedef ExternalIteratorHelper<ArgumentType, IteratorType, Begin, End>
+        IteratorHelper;
+      return getListAux<ArgumentType, IteratorHelper>
+        (ArgumentT, ListT, PredName);
+    }
+
+    /// Overloaded function template. Version for begin/end member
+    /// functions.
+    template <typename ArgumentType,
+              typename IteratorType,
+              IteratorType (ArgumentType::* Begin)() const,
+              IteratorType (ArgumentType::* End)() const>
+    foreign_t getCount(term_t ArgumentT, term_t CountT, StringRef PredName) {
+      typedef MemberIteratorHelper<ArgumentType, IteratorType, Begin, End>
+        IteratorHelper;
+      return getCountAux<ArgumentType, IteratorHelper>
+        (ArgumentT, CountT, PredName);
+    }
+
+    /// Overloaded function template. Version for begin/end ordinary
+    /// functions.
+    template <typename ArgumentType,
+              typename IteratorType,
+              IteratorType (* Begin)(const ArgumentType*),
+              IteratorType (* End)(const ArgumentType*)>
+    foreign_t getCount(term_t ArgumentT, term_t CountT, StringRef PredName) {
+      typedef ExternalIteratorHelper<ArgumentType, IteratorType, Begin, End>
+        IteratorHelper;
+      return getCountAux<ArgumentType, IteratorHelper>
+        (ArgumentT, CountT, PredName);
+    }
+
+    /// Overloaded function template. Version for containers with a
+    /// member function returning their size, that is used instead of
+    /// traversing the range. Only valid if elements can't be null (see
+    /// \c ElementMayBeNull).
+    template <typename ArgumentType,
+              typename SizeType,
+              SizeType (ArgumentType::* Size)() const>
+    foreign_t getCount(term_t ArgumentT, term_t CountT, StringRef PredName) {
+      typename Retrieve<ArgumentType>::argument_type Container;
+      if ( !Retrieve<ArgumentType>::_(ArgumentT, &Container, PredName))
+        return FALSE;
+      if ( !Container) return PL_unify_int64(CountT, 0);
+      return PL_unify_int64(CountT, (int64_t) (Container ->* Size)());
+    }
+
+    /// Non-deterministically unifies \c ResultT with the non-null
+    /// elements of \c Elems, an array held by some index that outlives
+    /// the enumeration. The context is just the position in the array,
+    /// so no memory has to be allocated. Exits deterministically on
+    /// the last element.
+    template <typename ElemType>
+    foreign_t getManyFromArray(term_t ResultT, ArrayRef<ElemType*> Elems,
+                               control_t Handle) {
+      size_t I = 0;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        break;
+      case PL_REDO:
+        I = PL_foreign_context(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+
+      for (; I < Elems.size(); ++I) {
+        if ( !Elems[I] || !plUnifyNode(ResultT, (void *) Elems[I]))
+          continue;                           // Cast above removes const
+        if (I + 1 == Elems.size()) return TRUE;
+        PL_retry(I + 1);
+      }
+      return FALSE;
+    }
+
+    /// Version of \c getOne() that can also be called with \c
+    /// ArgumentT free and \c ResultT bound. Then it enumerates the
+    /// individuals given by \c Inverse, typically held by an index
+    /// built the first time it is needed.
+    template <typename ArgumentType,
+              typename ResultType,
+              ResultType (ArgumentType::* Getter)() const,
+              ArrayRef<const void*> (* Inverse)(const void*)>
+    foreign_t getOneReversible(term_t ArgumentT, term_t ResultT,
+                               StringRef GetterName, control_t Handle) {
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        if ( !PL_is_variable(ArgumentT) || PL_is_variable(ResultT))
+          return getOne<ArgumentType, ResultType, Getter>
+            (ArgumentT, ResultT, GetterName);
+        break;
+      case PL_REDO:
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+      void *Result;
+      if ( !plGetNode(ResultT, &Result)) return FALSE;
+      return getManyFromArray<const void>(ArgumentT, Inverse(Result), Handle);
+    }
+
   } // End namespace crisp::prolog
 
 } // End namespace crisp
@@ -28,6 +28,29 @@
 #define pl_get_one(NAME, ARGTYPE, RESTYPE, CXXNAME)                     \
   foreign_t pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT);
 
+#undef pl_get_one_cached
+
+#define pl_get_one_cached(NAME, ARGTYPE, RESTYPE, CXXNAME)              \
+  pl_get_one(NAME, ARGTYPE, RESTYPE, CXXNAME)
+
+#undef pl_get_one_text
+
+#define pl_get_one_text(NAME, ARGTYPE, RESTYPE, CXXNAME)                \
+  pl_get_one(NAME, ARGTYPE, RESTYPE, CXXNAME)
+
+#undef pl_get_one_reversible
+
+#define pl_get_one_reversible(NAME, ARGTYPE, RESTYPE, CXXNAME)          \
+  foreign_t pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT,     \
+                                  control_t Handle);
+
+#undef pl_get_one_n
+
+#define pl_get_one_n(NAME, ARGTYPE, RESTYPE, INDEXTYPE, CXXNAME,        \
+                     SIZETYPE, SIZE)                                    \
+  foreign_t pl_##ARGTYPE##_##NAME##_n(term_t ArgumentT, term_t IndexT,  \
+                                      term_t ResultT, control_t Handle);
+
 #undef pl_check_property
 
 #define pl_check_property(VERB, NAME, ARGTYPE, CXXNAME)         \
@@ -37,4 +60,20 @@
 
 #define pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)        \
   foreign_t pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT,     \
-                                  control_t Handle);
+                                  control_t Handle);                    \
+  foreign_t pl_##ARGTYPE##_##NAME##_list(term_t ArgumentT,              \
+                                         term_t ListT);                 \
+  foreign_t pl_##ARGTYPE##_##NAME##_count(term_t ArgumentT,             \
+                                          term_t CountT);
+
+#undef pl_get_many_sized
+
+#define pl_get_many_sized(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND,  \
+                          SIZETYPE, SIZE)                               \
+  pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)
+
+#undef pl_get_many_reversible
+
+#define pl_get_many_reversible(NAME, ARGTYPE, ITERTYPE,                 \
+                               ITERBEGIN, ITEREND)                      \
+  pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)
@@ -34,6 +34,29 @@
       (ArgumentT, ResultT, #ARGTYPE "::" #NAME "/2");                   \
   }
 
+#undef pl_get_one_cached
+
+#define pl_get_one_cached(NAME,                                         \
+                          ARGTYPE, RESTYPE,                             \
+                          CXXNAME)                                      \
+  foreign_t                                                             \
+  pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT) {             \
+    return getOneCached<ARGTYPE, RESTYPE, &CXXNAME>                     \
+      (ArgumentT, ResultT, #ARGTYPE "::" #NAME "/2");                   \
+  }
+
+#undef pl_get_one_n
+
+#define pl_get_one_n(NAME, ARGTYPE, RESTYPE, INDEXTYPE, CXXNAME,        \
+                     SIZETYPE, SIZE)                                    \
+  foreign_t                                                             \
+  pl_##ARGTYPE##_##NAME##_n(term_t ArgumentT, term_t IndexT,            \
+                            term_t ResultT, control_t Handle) {         \
+    return getOneN<ARGTYPE, RESTYPE, INDEXTYPE, &CXXNAME,               \
+                   SIZETYPE, &SIZE>                                     \
+      (ArgumentT, IndexT, ResultT, #ARGTYPE "::" #NAME "/3", Handle);   \
+  }
+
 #undef pl_check_property
 
 #define pl_check_property(VERB, NAME, ARGTYPE, CXXNAME)                 \
@@ -42,6 +65,48 @@
       (ArgumentT, #ARGTYPE "::" #VERB "_" #NAME "/1");                  \
   }
 
+#undef pl_get_one_text
+
+#define pl_get_one_text(NAME,                                           \
+                        ARGTYPE, RESTYPE,                               \
+                        CXXNAME)                                        \
+  foreign_t                                                             \
+  pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT) {             \
+    return getOneText<ARGTYPE, RESTYPE, &CXXNAME>                       \
+      (ArgumentT, ResultT, #ARGTYPE "::" #NAME "/2");                   \
+  }
+
+#undef pl_get_one_reversible
+
+#define pl_get_one_reversible(NAME,                                     \
+                              ARGTYPE, RESTYPE,                         \
+                              CXXNAME)                                  \
+  foreign_t                                                             \
+  pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT,               \
+                        control_t Handle) {                             \
+    return getOneReversible<ARGTYPE, RESTYPE, &CXXNAME,                 \
+                            &inverse_##ARGTYPE##_##NAME>                \
+      (ArgumentT, ResultT, #ARGTYPE "::" #NAME "/2", Handle);           \
+  }
+
+#undef pl_get_many_list
+
+#define pl_get_many_list(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)   \
+  foreign_t pl_##ARGTYPE##_##NAME##_list(term_t ArgumentT,              \
+                                         term_t ListT) {                \
+    return getList<ARGTYPE, ITERTYPE, &ITERBEGIN, &ITEREND>             \
+      (ArgumentT, ListT, #ARGTYPE "::" #NAME "_list/2");                \
+  }
+
+#undef pl_get_many_count
+
+#define pl_get_many_count(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)  \
+  foreign_t pl_##ARGTYPE##_##NAME##_count(term_t ArgumentT,             \
+                                          term_t CountT) {              \
+    return getCount<ARGTYPE, ITERTYPE, &ITERBEGIN, &ITEREND>            \
+      (ArgumentT, CountT, #ARGTYPE "::" #NAME "_count/2");              \
+  }
+
 #undef pl_get_many
 
 #define pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)        \
@@ -49,4 +114,40 @@
                          control_t Handle) {                            \
     return getMany<ARGTYPE, ITERTYPE, &ITERBEGIN, &ITEREND>             \
       (ArgumentT, ResultT, #ARGTYPE "::" #NAME "/2", Handle);           \
+  }                                                                     \
+  pl_get_many_list(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)         \
+  pl_get_many_count(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)
+
+#undef pl_get_many_sized
+
+#define pl_get_many_sized(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND,  \
+                          SIZETYPE, SIZE)                               \
+  foreign_t pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT,     \
+                         control_t Handle) {                            \
+    return getMany<ARGTYPE, ITERTYPE, &ITERBEGIN, &ITEREND>             \
+      (ArgumentT, ResultT, #ARGTYPE "::" #NAME "/2", Handle);           \
+  }                                                                     \
+  pl_get_many_list(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)         \
+  foreign_t pl_##ARGTYPE##_##NAME##_count(term_t ArgumentT,             \
+                                          term_t CountT) {              \
+    /* The size counts null elements, that the list skips */           \
+    if (ElementMayBeNull<std::iterator_traits<ITERTYPE>::value_type>    \
+        ::value)                                                        \
+      return getCount<ARGTYPE, ITERTYPE, &ITERBEGIN, &ITEREND>          \
+        (ArgumentT, CountT, #ARGTYPE "::" #NAME "_count/2");            \
+    return getCount<ARGTYPE, SIZETYPE, &SIZE>                           \
+      (ArgumentT, CountT, #ARGTYPE "::" #NAME "_count/2");              \
   }
+
+#undef pl_get_many_reversible
+
+#define pl_get_many_reversible(NAME, ARGTYPE, ITERTYPE,                 \
+                               ITERBEGIN, ITEREND)                      \
+  foreign_t pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT,     \
+                         control_t Handle) {                            \
+    return getManyReversible<ARGTYPE, ITERTYPE, &ITERBEGIN, &ITEREND,   \
+                             &inverse_##ARGTYPE##_##NAME>               \
+      (ArgumentT, ResultT, #ARGTYPE "::" #NAME "/2", Handle);           \
+  }                                                                     \
+  pl_get_many_list(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)         \
+  pl_get_many_count(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)
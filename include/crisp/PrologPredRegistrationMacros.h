@@ -32,6 +32,37 @@
     return FALSE;                                                       \
   }
 
+#undef pl_get_one_cached
+
+#define pl_get_one_cached(NAME, ARGTYPE, RESTYPE, CXXNAME)              \
+  pl_get_one(NAME, ARGTYPE, RESTYPE, CXXNAME)
+
+#undef pl_get_one_text
+
+#define pl_get_one_text(NAME, ARGTYPE, RESTYPE, CXXNAME)                \
+  pl_get_one(NAME, ARGTYPE, RESTYPE, CXXNAME)
+
+#undef pl_get_one_reversible
+
+#define pl_get_one_reversible(NAME, ARGTYPE, RESTYPE, CXXNAME)          \
+  if ( !PL_register_foreign(#ARGTYPE "::" #NAME, 2,                     \
+                            (pl_function_t)                             \
+                            &pl_##ARGTYPE##_##NAME,                     \
+                            PL_FA_NONDETERMINISTIC)) {                  \
+    return FALSE;                                                       \
+  }
+
+#undef pl_get_one_n
+
+#define pl_get_one_n(NAME, ARGTYPE, RESTYPE, INDEXTYPE, CXXNAME,        \
+                     SIZETYPE, SIZE)                                    \
+  if ( !PL_register_foreign(#ARGTYPE "::" #NAME, 3,                     \
+                            (pl_function_t)                             \
+                            &pl_##ARGTYPE##_##NAME##_n,                 \
+                            PL_FA_NONDETERMINISTIC)) {                  \
+    return FALSE;                                                       \
+  }
+
 #undef pl_check_property
 
 #define pl_check_property(VERB, NAME, ARGTYPE, CXXNAME)                 \
@@ -49,4 +80,26 @@
                             &pl_##ARGTYPE##_##NAME,                     \
                             PL_FA_NONDETERMINISTIC)) {                  \
     return FALSE;                                                       \
+  }                                                                     \
+  if ( !PL_register_foreign(#ARGTYPE "::" #NAME "_list", 2,             \
+                            (pl_function_t)                             \
+                            &pl_##ARGTYPE##_##NAME##_list, 0)) {        \
+    return FALSE;                                                       \
+  }                                                                     \
+  if ( !PL_register_foreign(#ARGTYPE "::" #NAME "_count", 2,            \
+                            (pl_function_t)                             \
+                            &pl_##ARGTYPE##_##NAME##_count, 0)) {       \
+    return FALSE;                                                       \
   }
+
+#undef pl_get_many_sized
+
+#define pl_get_many_sized(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND,  \
+                          SIZETYPE, SIZE)                               \
+  pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)
+
+#undef pl_get_many_reversible
+
+#define pl_get_many_reversible(NAME, ARGTYPE, ITERTYPE,                 \
+                               ITERBEGIN, ITEREND)                      \
+  pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)
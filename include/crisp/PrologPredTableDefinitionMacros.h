@@ -0,0 +1,82 @@
+/* PrologPredTableDefinitionMacros.h ------------------------------*- C++ -*- */
+
+/* Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+
+   This file is part of Crisp.
+
+   Crisp is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Crisp is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** \file \brief Preprocessor macro definitions to \e define the
+ *  functions of generated predicates when \c CRISP_PREDICATE_TABLES
+ *  is set. Getters and property checkers get a constant \c
+ *  ErasedGetter and a trampoline that passes it to a shared
+ *  dispatcher, so that the row registering the trampoline (see
+ *  PrologPredTableMacros.h) is bound to its getter at compile time.
+ */
+
+#include "crisp/PrologPredDefinitionMacros.h"
+
+#undef pl_erased_getter
+
+#define pl_erased_getter(ID, PREDNAME, ARGTYPE, RESTYPE, CXXNAME)       \
+  const ErasedGetter ID = {                                             \
+    PREDNAME,                                                           \
+    reinterpret_cast<ErasedMethod>                                      \
+    (static_cast<RESTYPE (ARGTYPE::*)() const>(&CXXNAME))               \
+  };
+
+#undef pl_get_one
+
+#define pl_get_one(NAME, ARGTYPE, RESTYPE, CXXNAME)                     \
+  pl_erased_getter(pl_##ARGTYPE##_##NAME##_getter, #ARGTYPE "::" #NAME, \
+                   ARGTYPE, RESTYPE, CXXNAME)                           \
+  foreign_t                                                             \
+  pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT) {             \
+    return dispatchGetOne<ARGTYPE, RESTYPE, Unify<RESTYPE> >            \
+      (ArgumentT, ResultT, pl_##ARGTYPE##_##NAME##_getter);             \
+  }
+
+#undef pl_get_one_cached
+
+#define pl_get_one_cached(NAME, ARGTYPE, RESTYPE, CXXNAME)              \
+  pl_erased_getter(pl_##ARGTYPE##_##NAME##_getter, #ARGTYPE "::" #NAME, \
+                   ARGTYPE, RESTYPE, CXXNAME)                           \
+  foreign_t                                                             \
+  pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT) {             \
+    return dispatchGetOneCached<ARGTYPE, RESTYPE, Unify<RESTYPE> >      \
+      (ArgumentT, ResultT, pl_##ARGTYPE##_##NAME##_getter);             \
+  }
+
+#undef pl_get_one_text
+
+#define pl_get_one_text(NAME, ARGTYPE, RESTYPE, CXXNAME)                \
+  pl_erased_getter(pl_##ARGTYPE##_##NAME##_getter, #ARGTYPE "::" #NAME, \
+                   ARGTYPE, RESTYPE, CXXNAME)                           \
+  foreign_t                                                             \
+  pl_##ARGTYPE##_##NAME(term_t ArgumentT, term_t ResultT) {             \
+    return dispatchGetOneCached<ARGTYPE, RESTYPE, UnifyText<RESTYPE> >  \
+      (ArgumentT, ResultT, pl_##ARGTYPE##_##NAME##_getter);             \
+  }
+
+#undef pl_check_property
+
+#define pl_check_property(VERB, NAME, ARGTYPE, CXXNAME)                 \
+  pl_erased_getter(pl_##ARGTYPE##_##VERB##_##NAME##_getter,             \
+                   #ARGTYPE "::" #VERB "_" #NAME, ARGTYPE, bool, CXXNAME) \
+  foreign_t pl_##ARGTYPE##_##VERB##_##NAME(term_t ArgumentT) {          \
+    return dispatchCheckProperty<ARGTYPE>                               \
+      (ArgumentT, pl_##ARGTYPE##_##VERB##_##NAME##_getter);             \
+  }
@@ -0,0 +1,86 @@
+/* PrologPredTableMacros.h ----------------------------------------*- C++ -*- */
+
+/* Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+
+   This file is part of Crisp.
+
+   Crisp is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Crisp is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** \file \brief Preprocessor macro definitions to build the rows of a
+ *  \c PredicateDescriptor table (see crisp/PredicateTable.h) from
+ *  functionality automatically grasped from LLVM or Clang sources.
+ */
+
+#undef pl_table_row
+
+#define pl_table_row(PREDNAME, ARITY, FUNCTION, FLAGS)                  \
+  { PREDNAME, ARITY, (pl_function_t) FUNCTION, FLAGS },
+
+#undef pl_get_one
+
+#define pl_get_one(NAME, ARGTYPE, RESTYPE, CXXNAME)                     \
+  pl_table_row(#ARGTYPE "::" #NAME, 2, &pl_##ARGTYPE##_##NAME, 0)
+
+#undef pl_get_one_cached
+
+#define pl_get_one_cached(NAME, ARGTYPE, RESTYPE, CXXNAME)              \
+  pl_table_row(#ARGTYPE "::" #NAME, 2, &pl_##ARGTYPE##_##NAME, 0)
+
+#undef pl_get_one_text
+
+#define pl_get_one_text(NAME, ARGTYPE, RESTYPE, CXXNAME)                \
+  pl_table_row(#ARGTYPE "::" #NAME, 2, &pl_##ARGTYPE##_##NAME, 0)
+
+#undef pl_check_property
+
+#define pl_check_property(VERB, NAME, ARGTYPE, CXXNAME)                 \
+  pl_table_row(#ARGTYPE "::" #VERB "_" #NAME, 1,                        \
+               &pl_##ARGTYPE##_##VERB##_##NAME, 0)
+
+#undef pl_get_one_n
+
+#define pl_get_one_n(NAME, ARGTYPE, RESTYPE, INDEXTYPE, CXXNAME,        \
+                     SIZETYPE, SIZE)                                    \
+  pl_table_row(#ARGTYPE "::" #NAME, 3, &pl_##ARGTYPE##_##NAME##_n,      \
+               PL_FA_NONDETERMINISTIC)
+
+#undef pl_get_one_reversible
+
+#define pl_get_one_reversible(NAME, ARGTYPE, RESTYPE, CXXNAME)          \
+  pl_table_row(#ARGTYPE "::" #NAME, 2, &pl_##ARGTYPE##_##NAME,          \
+               PL_FA_NONDETERMINISTIC)
+
+#undef pl_get_many
+
+#define pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)        \
+  pl_table_row(#ARGTYPE "::" #NAME, 2, &pl_##ARGTYPE##_##NAME,          \
+               PL_FA_NONDETERMINISTIC)                                  \
+  pl_table_row(#ARGTYPE "::" #NAME "_list", 2,                          \
+               &pl_##ARGTYPE##_##NAME##_list, 0)                        \
+  pl_table_row(#ARGTYPE "::" #NAME "_count", 2,                         \
+               &pl_##ARGTYPE##_##NAME##_count, 0)
+
+#undef pl_get_many_sized
+
+#define pl_get_many_sized(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND,  \
+                          SIZETYPE, SIZE)                               \
+  pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)
+
+#undef pl_get_many_reversible
+
+#define pl_get_many_reversible(NAME, ARGTYPE, ITERTYPE,                 \
+                               ITERBEGIN, ITEREND)                      \
+  pl_get_many(NAME, ARGTYPE, ITERTYPE, ITERBEGIN, ITEREND)
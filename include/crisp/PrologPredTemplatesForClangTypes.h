@@ -23,6 +23,7 @@
 #include "clang/AST/DeclBase.h"
 #include "clang/AST/Type.h"
 
+#include "crisp/PredicateTable.h"
 #include "crisp/PrologPredBaseTemplates.h"
 
 using namespace llvm;
@@ -39,7 +40,7 @@ namespace crisp {
 
       static inline int
       _(term_t ArgumentT, argument_type* A, StringRef PredName) {
-        if ( !PL_get_pointer(ArgumentT, (void **) A))
+        if ( !plGetNode(ArgumentT, (void **) A))
           return pl_warning(PredName + ": instantiation fault on first arg");
         return TRUE;
       }
@@ -90,6 +91,28 @@ namespace crisp {
       }
     };
 
+    /// Specialization for \c QualType (that is a smart pointer) as \c
+    /// ArgumentType.
+    template <typename ResultType>
+    struct GetErased<QualType, ResultType> {
+      typedef QualType argument_type;
+      typedef ResultType (QualType::* getter_type)() const;
+      static inline ResultType _(argument_type A, getter_type Getter) {
+        return (A .* Getter)();
+      }
+    };
+
+    /// Specialization for \c QualType (that is a smart pointer) as \c
+    /// ArgumentType.
+    template <>
+    struct CheckErased<QualType> {
+      typedef QualType argument_type;
+      typedef bool (QualType::* predicate_type)() const;
+      static inline foreign_t _(argument_type A, predicate_type Predicate) {
+        return (A .* Predicate)() ? TRUE : FALSE;
+      }
+    };
+
     /// Specialization for \c Qualifiers.
     template <bool (Qualifiers::* Predicate)() const>
     struct Check<Qualifiers, Predicate> {
@@ -107,7 +130,7 @@ namespace crisp {
     struct Unify<QualType> {
       typedef QualType result_type;
       static inline foreign_t _(term_t ResultT, const result_type& Result) {
-        return PL_unify_pointer(ResultT, Result.getAsOpaquePtr());
+        return plUnifyNode(ResultT, Result.getAsOpaquePtr());
       }
     };
 
@@ -138,12 +161,18 @@ namespace crisp {
       static inline foreign_t _(term_t ResultT, const result_type Result) {
         if ( !Result) return FALSE;
         if ( const Decl* D = dyn_cast<Decl>(Result))
-          return PL_unify_pointer(ResultT, (void *) D); // Cast removes const
+          return plUnifyNode(ResultT, (void *) D); // Cast removes const
         else
           return FALSE;
       }
     };
 
+    /// Specialization for \c clang::DeclContext::decl_iterator, that
+    /// is just a pointer to a \c Decl.
+    template <>
+    struct Context<DeclContext::decl_iterator>
+      : InPlaceContext<DeclContext::decl_iterator> {};
+
     /// Specialization for \c
     /// clang::DeclContext::specific_decl_iterator. As this class is
     /// in fact a smart pointer, we don't need dynamic memory
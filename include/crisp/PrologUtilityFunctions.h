@@ -29,7 +29,17 @@ namespace crisp {
 
   namespace prolog {
 
-    int plAssertIsA(void *Elem, const std::string &Sort);
+    /// Asserts fact \c Pred(Elem, Sort), \c isA(Elem, Sort) by default.
+    int plAssertIsA(void *Elem, const std::string &Sort,
+                    const char *Pred = "isA");
+
+    /// Selects whether one-shot text results (mangled names,
+    /// pretty-printed types) are returned as SWI-Prolog strings, that
+    /// are garbage collected with the stacks, instead of atoms, that
+    /// stay in the atom table.
+    void plSetStringResults(bool StringResults);
+
+    bool plStringResults();
 
   } // End namespace crisp::prolog
 
@@ -0,0 +1,68 @@
+// include/crisp/ResultCache.h ---------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Memoized results of expensive functional predicates.
+///
+/// Some getters (names, pretty-printed types, mangled names) build a
+/// \c std::string and an atom each time they are called, and rules
+/// call them again and again on the same nodes. Their results are
+/// kept as Prolog records, keyed by node and getter, until the Prolog
+/// engine is cleaned up (once per translation unit or LLVM module).
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <utility>
+#include <SWI-Prolog.h>
+
+#include "llvm/ADT/DenseMap.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    class ResultCache {
+    public:
+      /// Looks up the result of \c Getter for \c Node. A null \c
+      /// Result means that the getter is known to fail for \c Node.
+      bool lookup(const void *Node, const void *Getter,
+                  record_t &Result) const;
+
+      /// Records \c ResultT as the result of \c Getter for \c
+      /// Node. A null \c ResultT records a failure.
+      void insert(const void *Node, const void *Getter, term_t ResultT);
+
+      /// Erases all the records. Must be called while the Prolog
+      /// engine is still running.
+      void reset();
+
+    private:
+      typedef std::pair<const void*, const void*> KeyType;
+
+      llvm::DenseMap<KeyType, record_t> Results;
+    };
+
+    ResultCache &getResultCache();
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
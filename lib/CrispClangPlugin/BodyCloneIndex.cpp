@@ -0,0 +1,297 @@
+// BodyCloneIndex.cpp ------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <algorithm>
+#include <map>
+
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/Expr.h"
+#include "clang/AST/ExprCXX.h"
+#include "clang/AST/Stmt.h"
+#include "clang/AST/StmtCXX.h"
+
+#include "BodyCloneIndex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    namespace {
+
+      /// Computes the structural profile of a function body. Nodes
+      /// are optionally collected in the same (pre-)order they are
+      /// profiled, so that nodes of identical bodies can be matched.
+      class BodyProfiler {
+      public:
+        BodyProfiler(SmallVectorImpl<const void*> *Nodes = 0)
+          : Nodes(Nodes) {}
+
+        void profileFunction(const FunctionDecl *F);
+
+        const llvm::FoldingSetNodeID &getProfile() const {
+          return Profile;
+        }
+
+      private:
+        void profileStmt(const Stmt *S);
+        void profileContents(const Stmt *S);
+        void profileDeclRef(const Decl *D);
+        void profileAPInt(const llvm::APInt &Value);
+
+        void profileType(QualType T) {
+          Profile.AddPointer(T.getCanonicalType().getAsOpaquePtr());
+        }
+
+        void declareLocal(const Decl *D) {
+          unsigned Position = Locals.size();
+          Locals[D] = Position;
+          if (Nodes) Nodes->push_back(D);
+        }
+
+        llvm::FoldingSetNodeID Profile;
+        llvm::DenseMap<const Decl*, unsigned> Locals;
+        SmallVectorImpl<const void*> *Nodes;
+      };
+
+    } // End anonymous namespace
+
+    void BodyProfiler::profileFunction(const FunctionDecl *F) {
+      Profile.AddInteger(F->getNumParams());
+      for (unsigned I = 0; I < F->getNumParams(); ++I) {
+        declareLocal(F->getParamDecl(I));
+        profileType(F->getParamDecl(I)->getType());
+      }
+      // Constructor initializers are not part of the body, and are not
+      // compared.
+      if (const CXXConstructorDecl *C = dyn_cast<CXXConstructorDecl>(F))
+        if (C->getNumCtorInitializers() > 0) Profile.AddPointer(F);
+      profileStmt(F->getBody());
+    }
+
+    void BodyProfiler::profileStmt(const Stmt *S) {
+      if ( !S) {
+        Profile.AddInteger(Stmt::NoStmtClass);
+        return;
+      }
+      if (Nodes) Nodes->push_back(S);
+      Profile.AddInteger(S->getStmtClass());
+      if (const Expr *E = dyn_cast<Expr>(S)) profileType(E->getType());
+      profileContents(S);
+
+      Stmt::child_range Children = const_cast<Stmt*>(S)->children();
+      Profile.AddInteger(std::distance(Children.first, Children.second));
+      for (; Children; ++Children) profileStmt(*Children);
+    }
+
+    /// Profiles what is not in the children or type of \c S. The
+    /// contents of statement classes not handled here are not
+    /// compared: the statement itself is profiled, so that bodies
+    /// containing it have no clones.
+    void BodyProfiler::profileContents(const Stmt *S) {
+      if (const DeclRefExpr *DRE = dyn_cast<DeclRefExpr>(S)) {
+        profileDeclRef(DRE->getDecl());
+      } else if (const MemberExpr *ME = dyn_cast<MemberExpr>(S)) {
+        profileDeclRef(ME->getMemberDecl());
+        Profile.AddBoolean(ME->isArrow());
+      } else if (const IntegerLiteral *IL = dyn_cast<IntegerLiteral>(S)) {
+        profileAPInt(IL->getValue());
+      } else if (const FloatingLiteral *FL = dyn_cast<FloatingLiteral>(S)) {
+        profileAPInt(FL->getValue().bitcastToAPInt());
+      } else if (const CharacterLiteral *CL = dyn_cast<CharacterLiteral>(S)) {
+        Profile.AddInteger(CL->getValue());
+        Profile.AddInteger(CL->getKind());
+      } else if (const CXXBoolLiteralExpr *BL
+                 = dyn_cast<CXXBoolLiteralExpr>(S)) {
+        Profile.AddBoolean(BL->getValue());
+      } else if (const StringLiteral *SL = dyn_cast<StringLiteral>(S)) {
+        Profile.AddString(SL->getBytes());
+        Profile.AddInteger(SL->getKind());
+      } else if (const BinaryOperator *BO = dyn_cast<BinaryOperator>(S)) {
+        Profile.AddInteger(BO->getOpcode());
+      } else if (const UnaryOperator *UO = dyn_cast<UnaryOperator>(S)) {
+        Profile.AddInteger(UO->getOpcode());
+      } else if (const CastExpr *CE = dyn_cast<CastExpr>(S)) {
+        Profile.AddInteger(CE->getCastKind());
+      } else if (const UnaryExprOrTypeTraitExpr *UE
+                 = dyn_cast<UnaryExprOrTypeTraitExpr>(S)) {
+        Profile.AddInteger(UE->getKind());
+        if (UE->isArgumentType()) profileType(UE->getArgumentType());
+      } else if (const DeclStmt *DS = dyn_cast<DeclStmt>(S)) {
+        // Initializers are children of the statement
+        for (DeclStmt::const_decl_iterator I = DS->decl_begin(),
+               E = DS->decl_end(); I != E; ++I) {
+          if (const VarDecl *VD = dyn_cast<VarDecl>(*I)) {
+            declareLocal(VD);
+            profileType(VD->getType());
+            Profile.AddInteger(VD->getStorageClass());
+          } else {
+            Profile.AddPointer(*I);
+          }
+        }
+      } else if (const CXXConstructExpr *CE = dyn_cast<CXXConstructExpr>(S)) {
+        profileDeclRef(CE->getConstructor());
+        Profile.AddInteger(CE->getConstructionKind());
+        Profile.AddBoolean(CE->requiresZeroInitialization());
+      } else if (const CXXNewExpr *NE = dyn_cast<CXXNewExpr>(S)) {
+        profileDeclRef(NE->getOperatorNew());
+        profileType(NE->getAllocatedType());
+        Profile.AddBoolean(NE->isArray());
+      } else if (const CXXDeleteExpr *DE = dyn_cast<CXXDeleteExpr>(S)) {
+        profileDeclRef(DE->getOperatorDelete());
+        Profile.AddBoolean(DE->isArrayForm());
+        Profile.AddBoolean(DE->isGlobalDelete());
+      } else if (const LabelStmt *LS = dyn_cast<LabelStmt>(S)) {
+        declareLocal(LS->getDecl());
+      } else if (const GotoStmt *GS = dyn_cast<GotoStmt>(S)) {
+        profileDeclRef(GS->getLabel());
+      } else if (const CXXCatchStmt *CS = dyn_cast<CXXCatchStmt>(S)) {
+        if (CS->getExceptionDecl()) declareLocal(CS->getExceptionDecl());
+        profileType(CS->getCaughtType());
+      } else if ( !(isa<CompoundStmt>(S) || isa<ReturnStmt>(S)
+                    || isa<IfStmt>(S) || isa<WhileStmt>(S)
+                    || isa<ForStmt>(S) || isa<DoStmt>(S)
+                    || isa<SwitchStmt>(S) || isa<CaseStmt>(S)
+                    || isa<DefaultStmt>(S) || isa<BreakStmt>(S)
+                    || isa<ContinueStmt>(S) || isa<NullStmt>(S)
+                    || isa<ParenExpr>(S) || isa<CallExpr>(S)
+                    || isa<ArraySubscriptExpr>(S)
+                    || isa<ConditionalOperator>(S) || isa<CXXThisExpr>(S)
+                    || isa<ExprWithCleanups>(S)
+                    || isa<MaterializeTemporaryExpr>(S)
+                    || isa<CXXBindTemporaryExpr>(S) || isa<InitListExpr>(S)
+                    || isa<ImplicitValueInitExpr>(S)
+                    || isa<CXXNullPtrLiteralExpr>(S)
+                    || isa<CXXScalarValueInitExpr>(S)
+                    || isa<CXXThrowExpr>(S) || isa<CXXTryStmt>(S))) {
+        Profile.AddPointer(S);
+      }
+    }
+
+    void BodyProfiler::profileDeclRef(const Decl *D) {
+      llvm::DenseMap<const Decl*, unsigned>::const_iterator I
+        = Locals.find(D);
+      if (I != Locals.end()) {
+        Profile.AddBoolean(true);
+        Profile.AddInteger(I->second);
+      } else {
+        Profile.AddBoolean(false);
+        Profile.AddPointer(D ? D->getCanonicalDecl() : 0);
+      }
+    }
+
+    void BodyProfiler::profileAPInt(const llvm::APInt &Value) {
+      Profile.AddInteger(Value.getBitWidth());
+      for (unsigned I = 0; I < Value.getNumWords(); ++I)
+        Profile.AddInteger(Value.getRawData()[I]);
+    }
+
+    void BodyCloneIndex::addDecl(const Decl *D) {
+      if (const FunctionDecl *F = dyn_cast<FunctionDecl>(D))
+        if (F->doesThisDeclarationHaveABody()) Functions.push_back(F);
+    }
+
+    void BodyCloneIndex::build() {
+      Built = true;
+      // Any hash value is possible, so hashes are not DenseMap keys
+      std::map<unsigned, SmallVector<unsigned, 1> > ClassesByHash;
+      for (unsigned I = 0; I < Functions.size(); ++I) {
+        const FunctionDecl *F = Functions[I];
+        BodyProfiler Profiler;
+        Profiler.profileFunction(F);
+        const llvm::FoldingSetNodeID &Body = Profiler.getProfile();
+        SmallVector<unsigned, 1> &Candidates
+          = ClassesByHash[Body.ComputeHash()];
+        unsigned Class = 0;
+        while (Class < Candidates.size()
+               && !(Classes[Candidates[Class]].Body == Body))
+          ++Class;
+        if (Class < Candidates.size()) {
+          Class = Candidates[Class];
+        } else {
+          Class = Classes.size();
+          Candidates.push_back(Class);
+          Classes.push_back(CloneClass());
+          Classes.back().Body = Body;
+          UniqueBodies.push_back(F);
+        }
+        Classes[Class].Functions.push_back(F);
+        ClassOf[F] = Class;
+      }
+      // Profiles are only needed to build the classes
+      for (unsigned I = 0; I < Classes.size(); ++I)
+        Classes[I].Body.clear();
+    }
+
+    const FunctionDecl *BodyCloneIndex::getDefinition(const FunctionDecl *F) {
+      const FunctionDecl *Definition = 0;
+      if ( !F->hasBody(Definition)) return 0;
+      return Definition;
+    }
+
+    ArrayRef<const FunctionDecl*> BodyCloneIndex::getUniqueBodies() {
+      if ( !Built) build();
+      return UniqueBodies;
+    }
+
+    bool BodyCloneIndex::isUniqueBody(const FunctionDecl *F) {
+      ArrayRef<const FunctionDecl*> Clones = getClones(F);
+      return !Clones.empty() && Clones.front() == getDefinition(F);
+    }
+
+    ArrayRef<const FunctionDecl*>
+    BodyCloneIndex::getClones(const FunctionDecl *F) {
+      if ( !Built) build();
+      llvm::DenseMap<const FunctionDecl*, unsigned>::const_iterator I
+        = ClassOf.find(getDefinition(F));
+      if (I == ClassOf.end()) return ArrayRef<const FunctionDecl*>();
+      return Classes[I->second].Functions;
+    }
+
+    const BodyCloneIndex::NodeMap &
+    BodyCloneIndex::getCounterparts(const FunctionDecl *From,
+                                    const FunctionDecl *To) {
+      std::map<BodyPair, NodeMap>::iterator I
+        = Counterparts.find(BodyPair(From, To));
+      if (I != Counterparts.end()) return I->second;
+      NodeMap &Pairs = Counterparts[BodyPair(From, To)];
+      SmallVector<const void*, 64> FromNodes, ToNodes;
+      BodyProfiler(&FromNodes).profileFunction(From);
+      BodyProfiler(&ToNodes).profileFunction(To);
+      unsigned Size = std::min(FromNodes.size(), ToNodes.size());
+      for (unsigned Position = 0; Position < Size; ++Position)
+        Pairs.insert(std::make_pair(FromNodes[Position], ToNodes[Position]));
+      return Pairs;
+    }
+
+    const void *BodyCloneIndex::getCounterpart(const void *Node,
+                                               const FunctionDecl *From,
+                                               const FunctionDecl *To) {
+      From = getDefinition(From);
+      To = getDefinition(To);
+      if ( !From || !To) return 0;
+      if (Node == From) return To;
+      return getCounterparts(From, To).lookup(Node);
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
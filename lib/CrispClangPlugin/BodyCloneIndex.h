@@ -0,0 +1,105 @@
+// BodyCloneIndex.h --------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+/// \file
+/// \brief Structurally identical function bodies.
+
+#ifndef CRISPCLANGPLUGIN_BODYCLONEINDEX_H
+#define CRISPCLANGPLUGIN_BODYCLONEINDEX_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "clang/AST/Decl.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Partitions the function definitions of the translation unit
+    /// into classes of structurally identical bodies: same statement
+    /// tree, same operators and literals, same canonical types and
+    /// same referenced declarations, with local variables and
+    /// parameters identified by position. Source locations are
+    /// ignored, so macro-stamped or generated functions fall into the
+    /// same class. Classes are computed the first time they are
+    /// queried; two bodies are only considered identical after
+    /// comparing their full profiles, not just their hashes.
+    class BodyCloneIndex {
+    public:
+      BodyCloneIndex() : Built(false) {}
+
+      /// To be called during AST traversal.
+      void addDecl(const Decl *D);
+
+      /// Returns the first function definition (in traversal order)
+      /// of every class.
+      llvm::ArrayRef<const FunctionDecl*> getUniqueBodies();
+
+      bool isUniqueBody(const FunctionDecl *F);
+
+      /// Returns all the function definitions with the same body as
+      /// \c F (\c F included), or an empty list if \c F has no body.
+      llvm::ArrayRef<const FunctionDecl*> getClones(const FunctionDecl *F);
+
+      /// Returns the node (statement, parameter or local declaration)
+      /// of the body of \c To that corresponds to \c Node in the body
+      /// of \c From, or null if \c Node is not part of \c From.
+      /// \c From and \c To must be in the same class. Nodes of both
+      /// bodies are paired the first time they are queried.
+      const void *getCounterpart(const void *Node, const FunctionDecl *From,
+                                 const FunctionDecl *To);
+
+    private:
+      struct CloneClass {
+        llvm::FoldingSetNodeID Body;
+        llvm::SmallVector<const FunctionDecl*, 1> Functions;
+      };
+
+      typedef llvm::DenseMap<const void*, const void*> NodeMap;
+      typedef std::pair<const FunctionDecl*, const FunctionDecl*> BodyPair;
+
+      void build();
+
+      const FunctionDecl *getDefinition(const FunctionDecl *F);
+
+      const NodeMap &getCounterparts(const FunctionDecl *From,
+                                     const FunctionDecl *To);
+
+      bool Built;
+      std::vector<const FunctionDecl*> Functions;
+      std::vector<CloneClass> Classes;
+      std::vector<const FunctionDecl*> UniqueBodies;
+      llvm::DenseMap<const FunctionDecl*, unsigned> ClassOf;
+      std::map<BodyPair, NodeMap> Counterparts;
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
@@ -0,0 +1,166 @@
+// CFGCache.cpp ------------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "CFGCache.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    CFGCache::~CFGCache() {
+      // CFGs themselves are owned by the AnalysisDeclContextManager
+      for (llvm::DenseMap<const Decl*, FunctionCFG*>::iterator
+             I = ByDecl.begin(), E = ByDecl.end(); I != E; ++I)
+        delete I->second;
+    }
+
+    CFGCache::FunctionCFG *CFGCache::getFunctionCFG(const Decl *D) {
+      const FunctionDecl *FD = dyn_cast<FunctionDecl>(D);
+      if ( !FD || !FD->hasBody(FD) || FD->isDependentContext()) return 0;
+      llvm::DenseMap<const Decl*, FunctionCFG*>::iterator I = ByDecl.find(FD);
+      if (I != ByDecl.end()) return I->second;
+
+      FunctionCFG *F = 0;
+      if (const CFG *Graph = Manager.getContext(FD)->getCFG()) {
+        F = new FunctionCFG();
+        F->Graph = Graph;
+        F->Blocks.resize(Graph->getNumBlockIDs());
+        for (CFG::const_iterator B = Graph->begin(), BE = Graph->end();
+             B != BE; ++B) {
+          F->Blocks[(*B)->getBlockID()] = *B;
+          ByBlock[*B] = F;
+        }
+      }
+      ByDecl[FD] = F;                         // Failures are cached too
+      return F;
+    }
+
+    ArrayRef<const CFGBlock*> CFGCache::getBlocks(const Decl *D) {
+      FunctionCFG *F = getFunctionCFG(D);
+      if ( !F) return ArrayRef<const CFGBlock*>();
+      return F->Blocks;
+    }
+
+    ArrayRef<const CFGBlock*> CFGCache::getBlocks(const CFGBlock *B) {
+      FunctionCFG *F = ByBlock.lookup(B);
+      if ( !F) return ArrayRef<const CFGBlock*>();
+      return F->Blocks;
+    }
+
+    const CFG *CFGCache::getCFG(const Decl *D) {
+      FunctionCFG *F = getFunctionCFG(D);
+      return F ? F->Graph : 0;
+    }
+
+    /// Iterative data-flow algorithm, visiting blocks in reverse
+    /// post-order so that it converges in a few passes. Blocks
+    /// unreachable from the entry are dominated by every block.
+    void CFGCache::computeDominators(FunctionCFG &F) {
+      unsigned NumBlocks = F.Blocks.size();
+      const CFGBlock *Entry = &F.Graph->getEntry();
+
+      std::vector<const CFGBlock*> PostOrder;
+      llvm::BitVector Visited(NumBlocks);
+      std::vector< std::pair<const CFGBlock*, CFGBlock::const_succ_iterator> >
+        Stack;
+      Visited.set(Entry->getBlockID());
+      Stack.push_back(std::make_pair(Entry, Entry->succ_begin()));
+      while ( !Stack.empty()) {
+        const CFGBlock *B = Stack.back().first;
+        if (Stack.back().second == B->succ_end()) {
+          PostOrder.push_back(B);
+          Stack.pop_back();
+          continue;
+        }
+        const CFGBlock *Succ = *Stack.back().second++;
+        if ( !Succ || Visited.test(Succ->getBlockID())) continue;
+        Visited.set(Succ->getBlockID());
+        Stack.push_back(std::make_pair(Succ, Succ->succ_begin()));
+      }
+
+      F.Dominators.assign(NumBlocks, llvm::BitVector(NumBlocks, true));
+      F.Dominators[Entry->getBlockID()].reset();
+      F.Dominators[Entry->getBlockID()].set(Entry->getBlockID());
+      bool Changed = true;
+      while (Changed) {
+        Changed = false;
+        for (std::vector<const CFGBlock*>::reverse_iterator
+               I = PostOrder.rbegin(), E = PostOrder.rend(); I != E; ++I) {
+          const CFGBlock *B = *I;
+          if (B == Entry) continue;
+          llvm::BitVector New(NumBlocks, true);
+          for (CFGBlock::const_pred_iterator P = B->pred_begin(),
+                 PE = B->pred_end(); P != PE; ++P)
+            if (*P && Visited.test((*P)->getBlockID()))
+              New &= F.Dominators[(*P)->getBlockID()];
+          New.set(B->getBlockID());
+          if (New != F.Dominators[B->getBlockID()]) {
+            F.Dominators[B->getBlockID()] = New;
+            Changed = true;
+          }
+        }
+      }
+    }
+
+    void CFGCache::computeReachable(FunctionCFG &F) {
+      unsigned NumBlocks = F.Blocks.size();
+      F.Reachable.assign(NumBlocks, llvm::BitVector(NumBlocks));
+      std::vector<const CFGBlock*> Worklist;
+      for (unsigned Id = 0; Id < NumBlocks; ++Id) {
+        llvm::BitVector &Reachable = F.Reachable[Id];
+        Worklist.push_back(F.Blocks[Id]);
+        while ( !Worklist.empty()) {
+          const CFGBlock *B = Worklist.back();
+          Worklist.pop_back();
+          for (CFGBlock::const_succ_iterator S = B->succ_begin(),
+                 SE = B->succ_end(); S != SE; ++S) {
+            if ( !*S || Reachable.test((*S)->getBlockID())) continue;
+            Reachable.set((*S)->getBlockID());
+            Worklist.push_back(*S);
+          }
+        }
+      }
+    }
+
+    bool CFGCache::dominates(const CFGBlock *A, const CFGBlock *B) {
+      FunctionCFG *F = ByBlock.lookup(A);
+      if ( !F || F != ByBlock.lookup(B)) return false;
+      if (F->Dominators.empty()) computeDominators(*F);
+      return F->Dominators[B->getBlockID()].test(A->getBlockID());
+    }
+
+    const llvm::BitVector *CFGCache::getReachable(const CFGBlock *From) {
+      FunctionCFG *F = ByBlock.lookup(From);
+      if ( !F) return 0;
+      if (F->Reachable.empty()) computeReachable(*F);
+      return &F->Reachable[From->getBlockID()];
+    }
+
+    bool CFGCache::isReachable(const CFGBlock *From, const CFGBlock *To) {
+      const llvm::BitVector *Reachable = getReachable(From);
+      if ( !Reachable || ByBlock.lookup(From) != ByBlock.lookup(To))
+        return false;
+      return Reachable->test(To->getBlockID());
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
@@ -0,0 +1,96 @@
+// CFGCache.h --------------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Per translation unit cache of control-flow graphs.
+
+#ifndef CRISPCLANGPLUGIN_CFGCACHE_H
+#define CRISPCLANGPLUGIN_CFGCACHE_H
+
+#include <vector>
+
+#include "clang/AST/Decl.h"
+#include "clang/Analysis/AnalysisContext.h"
+#include "clang/Analysis/CFG.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Builds the CFG of each function at most once, through an \c
+    /// AnalysisDeclContextManager that lives as long as the
+    /// translation unit. Dominators and reachability between blocks
+    /// are computed, as bit vectors indexed by block ID, the first
+    /// time they are asked for a CFG.
+    class CFGCache {
+    public:
+      ~CFGCache();
+
+      /// Blocks of the CFG of \c D, indexed by block ID. Empty if \c D
+      /// is not a function with body, or is a template pattern.
+      llvm::ArrayRef<const CFGBlock*> getBlocks(const Decl *D);
+
+      /// Blocks of the CFG \c B belongs to, indexed by block ID. Empty
+      /// if \c B does not belong to a built CFG.
+      llvm::ArrayRef<const CFGBlock*> getBlocks(const CFGBlock *B);
+
+      /// Returns null under the same conditions as getBlocks().
+      const CFG *getCFG(const Decl *D);
+
+      /// True if every path from the entry block to \c B goes through
+      /// \c A. Both blocks must belong to an already built CFG.
+      bool dominates(const CFGBlock *A, const CFGBlock *B);
+
+      /// True if there is a path of one or more edges from \c From to
+      /// \c To. Both blocks must belong to an already built CFG.
+      bool isReachable(const CFGBlock *From, const CFGBlock *To);
+
+      /// Blocks reachable from \c From, as a bit vector indexed by
+      /// block ID. Null if \c From does not belong to a built CFG.
+      const llvm::BitVector *getReachable(const CFGBlock *From);
+
+    private:
+      struct FunctionCFG {
+        const CFG *Graph;
+        std::vector<const CFGBlock*> Blocks;
+        std::vector<llvm::BitVector> Dominators;
+        std::vector<llvm::BitVector> Reachable;
+      };
+
+      FunctionCFG *getFunctionCFG(const Decl *D);
+
+      void computeDominators(FunctionCFG &F);
+
+      void computeReachable(FunctionCFG &F);
+
+      AnalysisDeclContextManager Manager;
+      llvm::DenseMap<const Decl*, FunctionCFG*> ByDecl;
+      llvm::DenseMap<const CFGBlock*, FunctionCFG*> ByBlock;
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
@@ -0,0 +1,165 @@
+// CallGraphIndex.cpp ------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/Expr.h"
+#include "clang/AST/ExprCXX.h"
+#include "llvm/ADT/BitVector.h"
+
+#include "CallGraphIndex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    void CallGraphIndex::addDecl(const Decl *D) {
+      if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D)) getNode(FD);
+    }
+
+    unsigned CallGraphIndex::getNode(const FunctionDecl *FD) {
+      llvm::DenseMap<const void*, unsigned>::iterator I = NodeIds.find(FD);
+      if (I != NodeIds.end()) return I->second;
+      const FunctionDecl *Canonical = FD->getCanonicalDecl();
+      std::pair<llvm::DenseMap<const void*, unsigned>::iterator, bool> Ins
+        = NodeIds.insert(std::make_pair(Canonical, (unsigned) Nodes.size()));
+      if (Ins.second) {
+        Nodes.push_back(Canonical);
+        Calls.push_back(NodeCalls());
+      }
+      unsigned N = Ins.first->second;
+      NodeIds[FD] = N;
+      return N;
+    }
+
+    int CallGraphIndex::lookupNode(const void *Node) const {
+      llvm::DenseMap<const void*, unsigned>::const_iterator I
+        = NodeIds.find(Node);
+      if (I == NodeIds.end()) return -1;
+      return I->second;
+    }
+
+    void CallGraphIndex::scanCalls(Stmt *S, std::vector<Call> &Found) {
+      CallExpr *CE = dyn_cast<CallExpr>(S);
+      if (const FunctionDecl *Callee = CE ? CE->getDirectCallee() : 0) {
+        unsigned Kind = DirectCall;
+        if (CXXMemberCallExpr *MCE = dyn_cast<CXXMemberCallExpr>(CE)) {
+          // Qualified calls (as in 'Base::f()') are not dispatched
+          MemberExpr *ME = dyn_cast<MemberExpr>(MCE->getCallee()
+                                                ->IgnoreParens());
+          const CXXMethodDecl *MD = MCE->getMethodDecl();
+          if (MD && MD->isVirtual() && ME && !ME->hasQualifier())
+            Kind = VirtualCall;
+          Expr *Object = MCE->getImplicitObjectArgument();
+          if (Object && isa<CXXThisExpr>(Object->IgnoreParenImpCasts()))
+            Kind |= ThisCall;
+        }
+        unsigned CalleeNode = getNode(Callee);
+        for (unsigned K = DirectCall; K <= ThisCall; K <<= 1)
+          if (Kind & K) Found.push_back(Call(CalleeNode, K));
+      }
+      for (Stmt::child_range C = S->children(); C; ++C)
+        if (*C) scanCalls(*C, Found);
+    }
+
+    const CallGraphIndex::NodeCalls &CallGraphIndex::getNodeCalls(unsigned N) {
+      if (Calls[N].Scanned) return Calls[N];
+      std::vector<Call> Found;
+      const FunctionDecl *Definition = 0;
+      if (Nodes[N]->hasBody(Definition)) {
+        if (Stmt *Body = Definition->getBody()) scanCalls(Body, Found);
+        if (const CXXConstructorDecl *CD
+            = dyn_cast<CXXConstructorDecl>(Definition))
+          for (CXXConstructorDecl::init_const_iterator
+                 I = CD->init_begin(), E = CD->init_end(); I != E; ++I)
+            if ((*I)->getInit()) scanCalls((*I)->getInit(), Found);
+      }
+      std::sort(Found.begin(), Found.end());
+      Found.erase(std::unique(Found.begin(), Found.end()), Found.end());
+      // Scanning can add nodes, so Calls is only indexed now
+      NodeCalls &Result = Calls[N];
+      Result.Scanned = true;
+      for (std::vector<Call>::iterator I = Found.begin(), E = Found.end();
+           I != E; ++I) {
+        Edge NewEdge = { Nodes[I->first], I->second };
+        Result.Edges.push_back(NewEdge);
+        Result.Targets.push_back(I->first);
+      }
+      return Result;
+    }
+
+    // The result doubles as the queue of the search.
+    const std::vector<unsigned> &
+    CallGraphIndex::getReached(unsigned Caller, unsigned KindMask) {
+      std::pair<unsigned, unsigned> Key(Caller, KindMask);
+      std::map< std::pair<unsigned, unsigned>, std::vector<unsigned> >
+        ::iterator I = Reached.find(Key);
+      if (I != Reached.end()) return I->second;
+      std::vector<unsigned> Result;
+      llvm::BitVector Seen;
+      unsigned Next = 0;
+      for (unsigned U = Caller; ; U = Result[Next++]) {
+        const NodeCalls &UCalls = getNodeCalls(U);
+        Seen.resize(Nodes.size());
+        for (unsigned E = 0; E < UCalls.Edges.size(); ++E) {
+          if ( !(UCalls.Edges[E].Kind & KindMask)) continue;
+          unsigned T = UCalls.Targets[E];
+          if (Seen.test(T)) continue;
+          Seen.set(T);                      // Caller itself if cyclic
+          Result.push_back(T);
+        }
+        if (Next == Result.size()) break;
+      }
+      // Nodes are numbered in discovery order (traversed functions
+      // first), so solutions are enumerated in a stable order.
+      std::sort(Result.begin(), Result.end());
+      std::vector<unsigned> &Stored = Reached[Key];
+      Stored.swap(Result);
+      return Stored;
+    }
+
+    ArrayRef<CallGraphIndex::Edge>
+    CallGraphIndex::getCalls(const FunctionDecl *Caller) {
+      return getNodeCalls(getNode(Caller)).Edges;
+    }
+
+    bool CallGraphIndex::reaches(const FunctionDecl *Caller,
+                                 const void *Callee, unsigned KindMask) {
+      const std::vector<unsigned> &R
+        = getReached(getNode(Caller), KindMask & AnyCall);
+      // Every reachable function has been seen by now
+      int B = lookupNode(Callee);
+      if (B < 0) return false;
+      return std::binary_search(R.begin(), R.end(), (unsigned) B);
+    }
+
+    const FunctionDecl *
+    CallGraphIndex::getReachedAt(const FunctionDecl *Caller,
+                                 unsigned KindMask, unsigned Pos) {
+      const std::vector<unsigned> &R
+        = getReached(getNode(Caller), KindMask & AnyCall);
+      return Pos < R.size() ? Nodes[R[Pos]] : 0;
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
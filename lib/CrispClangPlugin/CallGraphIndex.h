@@ -0,0 +1,129 @@
+// CallGraphIndex.h --------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Call graph of a translation unit, with memoized
+/// reachability.
+
+#ifndef CRISPCLANGPLUGIN_CALLGRAPHINDEX_H
+#define CRISPCLANGPLUGIN_CALLGRAPHINDEX_H
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "clang/AST/Decl.h"
+#include "clang/AST/Stmt.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Call edges between the functions of a translation unit. Nodes
+    /// are canonical declarations, so all the redeclarations of a
+    /// function are the same node. The calls of a function are found
+    /// the first time they are needed, scanning the body of its
+    /// definition (and its constructor initializers), even if it was
+    /// not traversed: e.g. an implicit template instantiation.
+    ///
+    /// The functions reachable from a caller, through edges of some
+    /// kinds, are computed by a breadth-first search the first time
+    /// they are asked about, and kept for later queries.
+    class CallGraphIndex {
+    public:
+      /// Edge kinds. A call is either direct (statically bound) or
+      /// virtual (dynamically dispatched), and can also be a call on
+      /// \c this.
+      enum EdgeKind {
+        DirectCall = 1,
+        VirtualCall = 2,
+        ThisCall = 4,
+        AnyCall = DirectCall | VirtualCall | ThisCall
+      };
+
+      /// A call edge has a single kind. A call with several kinds gives
+      /// an edge per kind.
+      struct Edge {
+        const FunctionDecl *Callee;
+        unsigned Kind;
+      };
+
+      /// To be called during AST traversal. Traversed functions are
+      /// numbered first, in traversal order.
+      void addDecl(const Decl *D);
+
+      /// Edges from \c Caller, sorted by callee and kind.
+      llvm::ArrayRef<Edge> getCalls(const FunctionDecl *Caller);
+
+      /// True if there is a path of one or more edges, with kinds in \c
+      /// KindMask, from \c Caller to the function declared by \c
+      /// Callee. \c Callee is looked up by address, so it can be any
+      /// node: if it is not a function declaration it is not found.
+      bool reaches(const FunctionDecl *Caller, const void *Callee,
+                   unsigned KindMask);
+
+      /// Returns the function reachable from \c Caller (as in
+      /// reaches()) at position \c Pos in an internal order, or null
+      /// if there are less than \c Pos + 1 such functions.
+      const FunctionDecl *getReachedAt(const FunctionDecl *Caller,
+                                       unsigned KindMask, unsigned Pos);
+
+    private:
+      struct NodeCalls {
+        NodeCalls() : Scanned(false) {}
+        bool Scanned;
+        std::vector<Edge> Edges;
+        std::vector<unsigned> Targets;        // Callee nodes of Edges
+      };
+
+      unsigned getNode(const FunctionDecl *FD);
+
+      int lookupNode(const void *Node) const;
+
+      /// (Callee, Kind) node number and edge kind.
+      typedef std::pair<unsigned, unsigned> Call;
+
+      void scanCalls(Stmt *S, std::vector<Call> &Found);
+
+      /// Finds the calls of node \c N, if not done yet.
+      const NodeCalls &getNodeCalls(unsigned N);
+
+      /// Nodes reachable from node \c Caller, sorted.
+      const std::vector<unsigned> &getReached(unsigned Caller,
+                                              unsigned KindMask);
+
+      /// Every declaration seen, and its canonical declaration, map to
+      /// the node of the latter.
+      llvm::DenseMap<const void*, unsigned> NodeIds;
+      std::vector<const FunctionDecl*> Nodes;
+      std::vector<NodeCalls> Calls;
+      /// Indexed by (Caller, KindMask).
+      std::map< std::pair<unsigned, unsigned>, std::vector<unsigned> >
+        Reached;
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
@@ -18,14 +18,19 @@
    along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "crisp/DeclNameIndexPredicates.h"
 #include "ClangPrologPredicates.h"
 #include "ClangPrologPredicateRegistration.h"
 
 int plRegisterPredicates() {
 
   /* Automatically generated function registration. */
+#ifdef CRISP_PREDICATE_TABLES
+  if ( !plRegisterGeneratedPredicates()) return FALSE;
+#else
 #include "crisp/PrologPredRegistrationMacros.h"
 #include "ClangDeclarations.inc"
+#endif
 
   /* Manual function registration. */
   PL_register_foreign("isConstFunctionProtoType", 1,
@@ -33,6 +38,92 @@ int plRegisterPredicates() {
                       0);
   PL_register_foreign("mangleName", 2,
                       (pl_function_t) &pl_mangleName, 0);
+  PL_register_foreign("canonicalType", 2,
+                      (pl_function_t) &pl_canonicalType, 0);
+  PL_register_foreign("desugaredType", 2,
+                      (pl_function_t) &pl_desugaredType, 0);
+  PL_register_foreign("canonicalPointee", 2,
+                      (pl_function_t) &pl_canonicalPointee, 0);
+  PL_register_foreign("canonicalTypeName", 2,
+                      (pl_function_t) &pl_canonicalTypeName, 0);
+  PL_register_foreign("declByName", 2,
+                      (pl_function_t) &pl_declByName,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("declByQualifiedName", 2,
+                      (pl_function_t) &pl_declByQualifiedName,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("descendant", 2,
+                      (pl_function_t) &pl_descendant,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("stmtOfClass", 3,
+                      (pl_function_t) &pl_stmtOfClass,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("parent", 2,
+                      (pl_function_t) &pl_parent, 0);
+  PL_register_foreign("ancestor", 2,
+                      (pl_function_t) &pl_ancestor,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("enclosingDecl", 2,
+                      (pl_function_t) &pl_enclosingDecl, 0);
+  PL_register_foreign("calls", 3,
+                      (pl_function_t) &pl_calls,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("reaches", 2,
+                      (pl_function_t) &pl_reaches,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("reaches", 3,
+                      (pl_function_t) &pl_reachesByKind,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("base+", 2,
+                      (pl_function_t) &pl_basePlus,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("overrides+", 2,
+                      (pl_function_t) &pl_overridesPlus,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("finalOverrider", 3,
+                      (pl_function_t) &pl_finalOverrider,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("isPolymorphic", 1,
+                      (pl_function_t) &pl_isPolymorphic, 0);
+  PL_register_foreign("instantiationKey", 2,
+                      (pl_function_t) &pl_instantiationKey, 0);
+  PL_register_foreign("isTemplatePattern", 1,
+                      (pl_function_t) &pl_isTemplatePattern, 0);
+  PL_register_foreign("uniqueBody", 1,
+                      (pl_function_t) &pl_uniqueBody,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("bodyClone", 2,
+                      (pl_function_t) &pl_bodyClone,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("bodyCounterpart", 4,
+                      (pl_function_t) &pl_bodyCounterpart, 0);
+  PL_register_foreign("cfgBlock", 2,
+                      (pl_function_t) &pl_cfgBlock,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("cfgEntry", 2,
+                      (pl_function_t) &pl_cfgEntry, 0);
+  PL_register_foreign("cfgExit", 2,
+                      (pl_function_t) &pl_cfgExit, 0);
+  PL_register_foreign("cfgSucc", 2,
+                      (pl_function_t) &pl_cfgSucc,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("cfgElement", 2,
+                      (pl_function_t) &pl_cfgElement,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("dominates", 2,
+                      (pl_function_t) &pl_dominates, 0);
+  PL_register_foreign("cfgReachable", 2,
+                      (pl_function_t) &pl_cfgReachable,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("getPresumedLoc", 4,
+                      (pl_function_t) &pl_getPresumedLoc, 0);
+  PL_register_foreign("presumedLocs", 2,
+                      (pl_function_t) &pl_presumedLocs, 0);
+  PL_register_foreign("nodeInRange", 4,
+                      (pl_function_t) &pl_nodeInRange,
+                      PL_FA_NONDETERMINISTIC);
+  PL_register_foreign("namingViolations", 2,
+                      (pl_function_t) &pl_namingViolations, 0);
   PL_register_foreign("report_violation", 3,
                       (pl_function_t) &pl_reportViolation, 0);
 
@@ -17,6 +17,7 @@
 // You should have received a copy of the GNU General Public License
 // along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <cstring>
 #include <string>
 
 #include "clang/AST/ASTContext.h"
@@ -34,12 +35,18 @@
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Frontend/CompilerInstance.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include "crisp/DeclNameIndex.h"
+#include "crisp/PredicateTable.h"
 #include "crisp/PrologPredTemplatesForClangTypes.h"
 #include "CompilationInfo.h"
 #include "ClangPrologPredicates.h"
+#include "NamingConventions.h"
+#include "RelationInverses.h"
+#include "TemplateInstantiations.h"
 
 using namespace clang;
 
@@ -47,10 +54,53 @@ namespace crisp {
 
   namespace prolog {
 
+    // Inverses of the generated relations that are reversible. The
+    // bound node may be of any kind, so it is looked up by address in
+    // the indexes, and only used once it has been found there.
+
+    const void *inverse_CXXRecordDecl_method(const void *Node) {
+      return dyn_cast_or_null<CXXRecordDecl>
+        (getCompilationInfo()->getDeclContextIndex().getContext(Node));
+    }
+
+    const void *inverse_Stmt_child(const void *Node) {
+      // ParentMap is keyed by address: other nodes have no parent
+      return getCompilationInfo()->getParentIndex()
+        .getParent(static_cast<const Stmt*>(Node));
+    }
+
+    ArrayRef<const void*> inverse_Decl_declContext(const void *Node) {
+      return getCompilationInfo()->getDeclContextIndex().getDecls(Node);
+    }
+
     // Automatically generated function definitions.
 
+#if defined(CRISP_DECL_SHARDS)
+    // Compiled in shards, see ClangPrologPredicatesShard.cpp.
+#ifdef CRISP_PREDICATE_TABLES
+    int plRegisterGeneratedPredicates() {
+      return plRegisterLinkedPredicateTables();
+    }
+#endif
+#elif defined(CRISP_PREDICATE_TABLES)
+    namespace {
+#include "crisp/PrologPredTableDefinitionMacros.h"
+#include "ClangDeclarations.inc"
+    }
+
+    static const PredicateDescriptor GeneratedPredicates[] = {
+#include "crisp/PrologPredTableMacros.h"
+#include "ClangDeclarations.inc"
+      { 0, 0, 0, 0 }
+    };
+
+    int plRegisterGeneratedPredicates() {
+      return plRegisterPredicateTable(GeneratedPredicates);
+    }
+#else
 #include "crisp/PrologPredDefinitionMacros.h"
 #include "ClangDeclarations.inc"
+#endif
 
     // Manual function definition.
 
@@ -63,30 +113,618 @@ namespace crisp {
       return Check<Qualifiers, &Qualifiers::hasConst>::_(Q);
     }
 
+    /// Key of mangled names in the \c ResultCache.
+    static const char MangleNameId = 0;
+
     foreign_t pl_mangleName(term_t ArgumentT, term_t ResultT) {
       Retrieve<FunctionDecl>::argument_type Argument;
       if ( !Retrieve<FunctionDecl>::
            _(ArgumentT, &Argument, "FunctionDecl_mangleName/2")) return FALSE;
+      record_t Cached;
+      if (getResultCache().lookup(Argument, &MangleNameId, Cached))
+        return unifyCachedResult(ResultT, Cached);
       std::string StreamString, Result;
       llvm::raw_string_ostream Stream(StreamString);
       MangleContext *MC = getCompilationInfo()->getMangleContext();
       MC->mangleName(Argument, Stream);
       Result = Stream.str();
-      return Unify<std::string>::_(ResultT, Result);
+      term_t CachedT = PL_new_term_ref();
+      return cacheResult(Argument, &MangleNameId, ResultT, CachedT,
+                         UnifyText<std::string>::_(CachedT, Result));
     }
 
     foreign_t pl_getPresumedLoc(term_t DeclT, term_t FilenameT,
                                 term_t LineT, term_t ColT) {
       const Decl *D;
-      if ( !PL_get_pointer(DeclT, (void **) &D))
+      if ( !plGetNode(DeclT, (void **) &D))
         return PL_warning("getPresumedLoc/4: instantiation fault on first arg");
       const SourceManager &SM = getCompilationInfo()->getSourceManager();
       const PresumedLoc PL = SM.getPresumedLoc(D->getLocation());
-      if ( !PL_unify_atom_chars(FilenameT, PL.getFilename())) return FALSE;
+      if (PL.isInvalid()) return FALSE;
+      SourceLocationIndex &SLI = getCompilationInfo()->getSourceLocationIndex();
+      if ( !PL_unify_atom(FilenameT, SLI.getFileNameAtom(PL.getFilename())))
+        return FALSE;
       if ( !PL_unify_int64(LineT, (int64_t) PL.getLine())) return FALSE;
       return PL_unify_int64(ColT, (int64_t) PL.getColumn());
     }
 
+    foreign_t pl_presumedLocs(term_t DeclsT, term_t LocsT) {
+      const SourceManager &SM = getCompilationInfo()->getSourceManager();
+      SourceLocationIndex &SLI = getCompilationInfo()->getSourceLocationIndex();
+      functor_t LocF = PL_new_functor(PL_new_atom("loc"), 3);
+      term_t DeclsTail = PL_copy_term_ref(DeclsT);
+      term_t LocsTail = PL_copy_term_ref(LocsT);
+      term_t DeclT = PL_new_term_ref();
+      term_t LocT = PL_new_term_ref();
+      while (PL_get_list(DeclsTail, DeclT, DeclsTail)) {
+        const Decl *D;
+        if ( !plGetNode(DeclT, (void **) &D))
+          return PL_warning("presumedLocs/2: instantiation fault on first arg");
+        const PresumedLoc PL = SM.getPresumedLoc(D->getLocation());
+        if ( !PL_unify_list(LocsTail, LocT, LocsTail)) return FALSE;
+        if (PL.isInvalid()) {
+          if ( !PL_unify_atom_chars(LocT, "unknown")) return FALSE;
+          continue;
+        }
+        if ( !PL_unify_term(LocT, PL_FUNCTOR, LocF,
+                            PL_ATOM, SLI.getFileNameAtom(PL.getFilename()),
+                            PL_INT64, (int64_t) PL.getLine(),
+                            PL_INT64, (int64_t) PL.getColumn()))
+          return FALSE;
+      }
+      if ( !PL_get_nil(DeclsTail))
+        return PL_warning("presumedLocs/2: first arg must be a proper list");
+      return PL_unify_nil(LocsTail);
+    }
+
+    foreign_t pl_nodeInRange(term_t FileT, term_t FirstLineT, term_t LastLineT,
+                             term_t NodeT, control_t Handle) {
+      unsigned Pos = 0;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        break;
+      case PL_REDO:
+        Pos = PL_foreign_context(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+      size_t Length;
+      char *Chars;
+      int FirstLine, LastLine;
+      if ( !PL_get_nchars(FileT, &Length, &Chars, CVT_ATOM | CVT_STRING))
+        return PL_warning("nodeInRange/4: instantiation fault on first arg");
+      if ( !PL_get_integer(FirstLineT, &FirstLine) ||
+           !PL_get_integer(LastLineT, &LastLine))
+        return PL_warning("nodeInRange/4: instantiation fault on line args");
+      if (FirstLine < 0 || LastLine < FirstLine) return FALSE;
+
+      SourceLocationIndex &SLI = getCompilationInfo()->getSourceLocationIndex();
+      StringRef File(Chars, Length);
+      const void *Node;
+      while ((Node = SLI.getNextInRange(File, FirstLine, LastLine, Pos))) {
+        ++Pos;
+        if (plUnifyNode(NodeT, Node)) {
+          if ( !SLI.getNextInRange(File, FirstLine, LastLine, Pos))
+            return TRUE;
+          PL_retry(Pos);
+        }
+      }
+      return FALSE;
+    }
+
+    foreign_t pl_canonicalType(term_t TypeT, term_t CanonicalTypeT) {
+      Retrieve<QualType>::argument_type Type;
+      if ( !Retrieve<QualType>::_(TypeT, &Type, "canonicalType/2"))
+        return FALSE;
+      TypeCache &TC = getCompilationInfo()->getTypeCache();
+      return Unify<QualType>::_(CanonicalTypeT, TC.getCanonicalType(Type));
+    }
+
+    foreign_t pl_desugaredType(term_t TypeT, term_t DesugaredTypeT) {
+      Retrieve<QualType>::argument_type Type;
+      if ( !Retrieve<QualType>::_(TypeT, &Type, "desugaredType/2"))
+        return FALSE;
+      TypeCache &TC = getCompilationInfo()->getTypeCache();
+      return Unify<QualType>::_(DesugaredTypeT, TC.getDesugaredType(Type));
+    }
+
+    foreign_t pl_canonicalPointee(term_t TypeT, term_t PointeeT) {
+      Retrieve<QualType>::argument_type Type;
+      if ( !Retrieve<QualType>::_(TypeT, &Type, "canonicalPointee/2"))
+        return FALSE;
+      TypeCache &TC = getCompilationInfo()->getTypeCache();
+      QualType Pointee = TC.getCanonicalPointee(Type);
+      if (Pointee.isNull()) return FALSE;
+      return Unify<QualType>::_(PointeeT, Pointee);
+    }
+
+    foreign_t pl_canonicalTypeName(term_t TypeT, term_t NameT) {
+      Retrieve<QualType>::argument_type Type;
+      if ( !Retrieve<QualType>::_(TypeT, &Type, "canonicalTypeName/2"))
+        return FALSE;
+      TypeCache &TC = getCompilationInfo()->getTypeCache();
+      return PL_unify_atom(NameT, TC.getCanonicalTypeName(Type));
+    }
+
+    foreign_t pl_descendant(term_t AncestorT, term_t NodeT,
+                            control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      Retrieve<Stmt>::argument_type Ancestor;
+      if ( !Retrieve<Stmt>::_(AncestorT, &Ancestor, "descendant/2"))
+        return FALSE;
+      StmtIndex &SI = getCompilationInfo()->getStmtIndex();
+      if ( !PL_is_variable(NodeT)) {
+        const Stmt *Node;
+        if ( !plGetNode(NodeT, (void **) &Node)) return FALSE;
+        return SI.isDescendant(Ancestor, Node) ? TRUE : FALSE;
+      }
+      return getManyFromArray<const Stmt>(NodeT, SI.getDescendants(Ancestor),
+                                          Handle);
+    }
+
+    foreign_t pl_stmtOfClass(term_t ScopeT, term_t ClassT, term_t StmtT,
+                             control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      char *ClassName;
+      size_t Length;
+      if ( !PL_get_nchars(ClassT, &Length, &ClassName, CVT_ATOM))
+        return pl_warning("stmtOfClass/3: instantiation fault on second arg");
+      Stmt::StmtClass Class
+        = getStmtClassByName(StringRef(ClassName, Length));
+      if (Class == Stmt::NoStmtClass)
+        return pl_warning(Twine("stmtOfClass/3: unknown statement class ")
+                          + ClassName);
+      StmtIndex &SI = getCompilationInfo()->getStmtIndex();
+
+      char *ScopeName;
+      if (PL_get_atom_chars(ScopeT, &ScopeName)) {
+        if (StringRef(ScopeName) != "translationUnit")
+          return pl_warning("stmtOfClass/3: unknown scope");
+        return getManyFromArray<const Stmt>(StmtT, SI.getStmtsOfClass(Class),
+                                            Handle);
+      }
+      Retrieve<Stmt>::argument_type Scope;
+      if ( !Retrieve<Stmt>::_(ScopeT, &Scope, "stmtOfClass/3"))
+        return FALSE;
+      return getManyFromArray<const Stmt>
+        (StmtT, SI.getStmtsOfClass(Scope, Class), Handle);
+    }
+
+    foreign_t pl_parent(term_t NodeT, term_t ParentT) {
+      Retrieve<Stmt>::argument_type Node;
+      if ( !Retrieve<Stmt>::_(NodeT, &Node, "parent/2")) return FALSE;
+      ParentIndex &PI = getCompilationInfo()->getParentIndex();
+      return Unify<const Stmt*>::_(ParentT, PI.getParent(Node));
+    }
+
+    foreign_t pl_ancestor(term_t NodeT, term_t AncestorT, control_t Handle) {
+      const Stmt *Current = 0;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL: {
+        Retrieve<Stmt>::argument_type Node;
+        if ( !Retrieve<Stmt>::_(NodeT, &Node, "ancestor/2")) return FALSE;
+        Current = Node;
+        break;
+      }
+      case PL_REDO:
+        Current = (const Stmt *) PL_foreign_context_address(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+
+      ParentIndex &PI = getCompilationInfo()->getParentIndex();
+      while ((Current = PI.getParent(Current))) {
+        if ( !plUnifyNode(AncestorT, (void *) Current)) continue;
+        if ( !PI.getParent(Current)) return TRUE; // Last one, the root
+        PL_retry_address((void *) Current);       // Cast removes const
+      }
+      return FALSE;
+    }
+
+    foreign_t pl_enclosingDecl(term_t NodeT, term_t DeclT) {
+      Retrieve<Stmt>::argument_type Node;
+      if ( !Retrieve<Stmt>::_(NodeT, &Node, "enclosingDecl/2")) return FALSE;
+      ParentIndex &PI = getCompilationInfo()->getParentIndex();
+      return Unify<const Decl*>::_(DeclT, PI.getEnclosingDecl(Node));
+    }
+
+    // Names of call graph edge kinds in Prolog, in bit order.
+    static const char *const CallKindNames[] = { "direct", "virtual", "this" };
+
+    /// Returns 0 if \c KindT is not the name of a call kind.
+    static unsigned getCallKind(term_t KindT) {
+      char *Name;
+      if ( !PL_get_atom_chars(KindT, &Name)) return 0;
+      for (unsigned I = 0; I < 3; ++I)
+        if ( !std::strcmp(Name, CallKindNames[I])) return 1u << I;
+      return 0;
+    }
+
+    static const char *getCallKindName(unsigned Kind) {
+      unsigned I = 0;
+      while (Kind >>= 1) ++I;
+      return CallKindNames[I];
+    }
+
+    /// Indexes keep a single declaration per entity (canonical one or
+    /// definition), but bound arguments can be any redeclaration.
+    static bool unifyDecl(term_t DeclT, const Decl *D) {
+      if (PL_is_variable(DeclT))
+        return plUnifyNode(DeclT, (void *) D); // Cast removes const
+      const Decl *Other;
+      if ( !plGetNode(DeclT, (void **) &Other) || !Other) return false;
+      return Other->getCanonicalDecl() == D->getCanonicalDecl();
+    }
+
+    /// As \c getManyFromArray, but bound \c DeclT is checked with \c
+    /// unifyDecl.
+    template <typename DeclType>
+    static foreign_t getManyDecls(term_t DeclT, ArrayRef<const DeclType*> Decls,
+                                  control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_FIRST_CALL &&
+          !PL_is_variable(DeclT)) {
+        for (unsigned I = 0; I < Decls.size(); ++I)
+          if (unifyDecl(DeclT, Decls[I])) return TRUE;
+        return FALSE;
+      }
+      return getManyFromArray<const DeclType>(DeclT, Decls, Handle);
+    }
+
+    foreign_t pl_calls(term_t CallerT, term_t CalleeT, term_t KindT,
+                       control_t Handle) {
+      size_t I = 0;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        break;
+      case PL_REDO:
+        I = PL_foreign_context(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+      Retrieve<FunctionDecl>::argument_type Caller;
+      if ( !Retrieve<FunctionDecl>::_(CallerT, &Caller, "calls/3"))
+        return FALSE;
+      unsigned KindMask = CallGraphIndex::AnyCall;
+      if ( !PL_is_variable(KindT) && !(KindMask = getCallKind(KindT)))
+        return pl_warning("calls/3: unknown call kind");
+      CallGraphIndex &CG = getCompilationInfo()->getCallGraphIndex();
+      ArrayRef<CallGraphIndex::Edge> Calls = CG.getCalls(Caller);
+
+      // Bindings of a partially unified edge must be undone
+      fid_t Frame = PL_open_foreign_frame();
+      for (; I < Calls.size(); ++I) {
+        if ( !(Calls[I].Kind & KindMask)) continue;
+        if (unifyDecl(CalleeT, Calls[I].Callee) &&
+            PL_unify_atom_chars(KindT, getCallKindName(Calls[I].Kind))) {
+          PL_close_foreign_frame(Frame);
+          if (I + 1 == Calls.size()) return TRUE;
+          PL_retry(I + 1);
+        }
+        PL_rewind_foreign_frame(Frame);
+      }
+      PL_close_foreign_frame(Frame);
+      return FALSE;
+    }
+
+    static foreign_t reaches(term_t CallerT, term_t CalleeT, unsigned KindMask,
+                             StringRef PredName, control_t Handle) {
+      unsigned Pos = 0;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        break;
+      case PL_REDO:
+        Pos = PL_foreign_context(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+      Retrieve<FunctionDecl>::argument_type Caller;
+      if ( !Retrieve<FunctionDecl>::_(CallerT, &Caller, PredName))
+        return FALSE;
+      CallGraphIndex &CG = getCompilationInfo()->getCallGraphIndex();
+
+      if ( !PL_is_variable(CalleeT)) {
+        void *Callee;                     // Any node, looked up by address
+        if ( !plGetNode(CalleeT, &Callee)) return FALSE;
+        return CG.reaches(Caller, Callee, KindMask) ? TRUE : FALSE;
+      }
+
+      const FunctionDecl *Callee = CG.getReachedAt(Caller, KindMask, Pos);
+      if ( !Callee || !plUnifyNode(CalleeT, (void *) Callee)) return FALSE;
+      if ( !CG.getReachedAt(Caller, KindMask, Pos + 1)) return TRUE;
+      PL_retry(Pos + 1);
+    }
+
+    foreign_t pl_reaches(term_t CallerT, term_t CalleeT, control_t Handle) {
+      return reaches(CallerT, CalleeT, CallGraphIndex::AnyCall, "reaches/2",
+                     Handle);
+    }
+
+    foreign_t pl_reachesByKind(term_t CallerT, term_t CalleeT, term_t KindT,
+                               control_t Handle) {
+      unsigned KindMask = getCallKind(KindT);
+      if ( !KindMask) return pl_warning("reaches/3: unknown call kind");
+      return reaches(CallerT, CalleeT, KindMask, "reaches/3", Handle);
+    }
+
+    foreign_t pl_basePlus(term_t ClassT, term_t BaseT, control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      Retrieve<CXXRecordDecl>::argument_type Class;
+      if ( !Retrieve<CXXRecordDecl>::_(ClassT, &Class, "base+/2"))
+        return FALSE;
+      ClassHierarchyIndex &CH = getCompilationInfo()->getClassHierarchyIndex();
+      return getManyDecls<CXXRecordDecl>(BaseT, CH.getBases(Class), Handle);
+    }
+
+    foreign_t pl_overridesPlus(term_t MethodT, term_t OverriddenT,
+                               control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      Retrieve<CXXMethodDecl>::argument_type Method;
+      if ( !Retrieve<CXXMethodDecl>::_(MethodT, &Method, "overrides+/2"))
+        return FALSE;
+      ClassHierarchyIndex &CH = getCompilationInfo()->getClassHierarchyIndex();
+      return getManyDecls<CXXMethodDecl>
+        (OverriddenT, CH.getOverriddenMethods(Method), Handle);
+    }
+
+    foreign_t pl_finalOverrider(term_t ClassT, term_t MethodT,
+                                term_t OverriderT, control_t Handle) {
+      size_t I = 0;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        break;
+      case PL_REDO:
+        I = PL_foreign_context(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+      Retrieve<CXXRecordDecl>::argument_type Class;
+      if ( !Retrieve<CXXRecordDecl>::_(ClassT, &Class, "finalOverrider/3"))
+        return FALSE;
+      ClassHierarchyIndex &CH = getCompilationInfo()->getClassHierarchyIndex();
+      ArrayRef<ClassHierarchyIndex::Overrider> Overriders
+        = CH.getFinalOverriders(Class);
+
+      // Bindings of a partially unified pair must be undone
+      fid_t Frame = PL_open_foreign_frame();
+      for (; I < Overriders.size(); ++I) {
+        if (unifyDecl(MethodT, Overriders[I].first) &&
+            unifyDecl(OverriderT, Overriders[I].second)) {
+          PL_close_foreign_frame(Frame);
+          if (I + 1 == Overriders.size()) return TRUE;
+          PL_retry(I + 1);
+        }
+        PL_rewind_foreign_frame(Frame);
+      }
+      PL_close_foreign_frame(Frame);
+      return FALSE;
+    }
+
+    foreign_t pl_isPolymorphic(term_t ClassT) {
+      Retrieve<CXXRecordDecl>::argument_type Class;
+      if ( !Retrieve<CXXRecordDecl>::_(ClassT, &Class, "isPolymorphic/1"))
+        return FALSE;
+      const CXXRecordDecl *Definition = Class->getDefinition();
+      return Definition && Definition->isPolymorphic() ? TRUE : FALSE;
+    }
+
+    foreign_t pl_instantiationKey(term_t DeclT, term_t KeyT) {
+      Retrieve<Decl>::argument_type Node;
+      if ( !Retrieve<Decl>::_(DeclT, &Node, "instantiationKey/2"))
+        return FALSE;
+      const NamedDecl *D = dyn_cast<NamedDecl>(Node);
+      if ( !D) return FALSE;
+      CompilationInfo *CI = getCompilationInfo();
+      std::string Key
+        = getInstantiationKey(D, CI->getCompilerInstance().getASTContext(),
+                              CI->getPrintingPolicy());
+      return PL_unify_atom_nchars(KeyT, Key.size(), Key.data());
+    }
+
+    foreign_t pl_uniqueBody(term_t FunctionT, control_t Handle) {
+      BodyCloneIndex &BC = getCompilationInfo()->getBodyCloneIndex();
+      if (PL_foreign_control(Handle) == PL_FIRST_CALL &&
+          !PL_is_variable(FunctionT)) {
+        Retrieve<FunctionDecl>::argument_type Function;
+        if ( !Retrieve<FunctionDecl>::_(FunctionT, &Function, "uniqueBody/1"))
+          return FALSE;
+        return BC.isUniqueBody(Function) ? TRUE : FALSE;
+      }
+      return getManyFromArray<const FunctionDecl>
+        (FunctionT, BC.getUniqueBodies(), Handle);
+    }
+
+    foreign_t pl_bodyClone(term_t FunctionT, term_t CloneT,
+                           control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      Retrieve<FunctionDecl>::argument_type Function;
+      if ( !Retrieve<FunctionDecl>::_(FunctionT, &Function, "bodyClone/2"))
+        return FALSE;
+      BodyCloneIndex &BC = getCompilationInfo()->getBodyCloneIndex();
+      return getManyDecls<FunctionDecl>(CloneT, BC.getClones(Function),
+                                        Handle);
+    }
+
+    foreign_t pl_bodyCounterpart(term_t NodeT, term_t FunctionT,
+                                 term_t CloneT, term_t CounterpartT) {
+      const void *Node;
+      if ( !plGetNode(NodeT, (void **) &Node))
+        return PL_warning("bodyCounterpart/4: "
+                          "instantiation fault on first arg");
+      Retrieve<FunctionDecl>::argument_type Function, Clone;
+      if ( !Retrieve<FunctionDecl>::
+           _(FunctionT, &Function, "bodyCounterpart/4") ||
+           !Retrieve<FunctionDecl>::_(CloneT, &Clone, "bodyCounterpart/4"))
+        return FALSE;
+      BodyCloneIndex &BC = getCompilationInfo()->getBodyCloneIndex();
+      const void *Counterpart = BC.getCounterpart(Node, Function, Clone);
+      return Counterpart && plUnifyNode(CounterpartT, (void *) Counterpart);
+    }
+
+    foreign_t pl_isTemplatePattern(term_t DeclT) {
+      const Decl *D;
+      if ( !plGetNode(DeclT, (void **) &D))
+        return PL_warning("isTemplatePattern/1: "
+                          "instantiation fault on first arg");
+      return isTemplatePattern(D) ? TRUE : FALSE;
+    }
+
+    foreign_t pl_cfgBlock(term_t FunctionT, term_t BlockT, control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      Retrieve<FunctionDecl>::argument_type Function;
+      if ( !Retrieve<FunctionDecl>::_(FunctionT, &Function, "cfgBlock/2"))
+        return FALSE;
+      CFGCache &CC = getCompilationInfo()->getCFGCache();
+      return getManyFromArray<const CFGBlock>(BlockT, CC.getBlocks(Function),
+                                              Handle);
+    }
+
+    foreign_t pl_cfgEntry(term_t FunctionT, term_t BlockT) {
+      Retrieve<FunctionDecl>::argument_type Function;
+      if ( !Retrieve<FunctionDecl>::_(FunctionT, &Function, "cfgEntry/2"))
+        return FALSE;
+      const CFG *Graph = getCompilationInfo()->getCFGCache().getCFG(Function);
+      if ( !Graph) return FALSE;
+      return Unify<const CFGBlock*>::_(BlockT, &Graph->getEntry());
+    }
+
+    foreign_t pl_cfgExit(term_t FunctionT, term_t BlockT) {
+      Retrieve<FunctionDecl>::argument_type Function;
+      if ( !Retrieve<FunctionDecl>::_(FunctionT, &Function, "cfgExit/2"))
+        return FALSE;
+      const CFG *Graph = getCompilationInfo()->getCFGCache().getCFG(Function);
+      if ( !Graph) return FALSE;
+      return Unify<const CFGBlock*>::_(BlockT, &Graph->getExit());
+    }
+
+    foreign_t pl_cfgSucc(term_t BlockT, term_t SuccT, control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      const CFGBlock *Block;
+      if ( !plGetNode(BlockT, (void **) &Block) || !Block)
+        return pl_warning("cfgSucc/2: instantiation fault on first arg");
+      // Successors of pruned edges are null, and skipped
+      ArrayRef<CFGBlock*> Succs(Block->succ_begin(), Block->succ_end());
+      return getManyFromArray<CFGBlock>(SuccT, Succs, Handle);
+    }
+
+    foreign_t pl_cfgElement(term_t BlockT, term_t StmtT, control_t Handle) {
+      unsigned I = 0;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        break;
+      case PL_REDO:
+        I = PL_foreign_context(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+      const CFGBlock *Block;
+      if ( !plGetNode(BlockT, (void **) &Block) || !Block)
+        return pl_warning("cfgElement/2: instantiation fault on first arg");
+
+      // Only statement elements (not implicit destructors, etc.)
+      bool Found = false;
+      for (; I < Block->size(); ++I) {
+        CFGElement Element = (*Block)[I];
+        const CFGStmt *StmtElement = Element.getAs<CFGStmt>();
+        if ( !StmtElement) continue;
+        if (Found) PL_retry(I);               // One unified, more left
+        Found = plUnifyNode(StmtT, (void *) StmtElement->getStmt());
+      }
+      return Found ? TRUE : FALSE;
+    }
+
+    foreign_t pl_dominates(term_t BlockT, term_t DominatedT) {
+      const CFGBlock *Block, *Dominated;
+      if ( !plGetNode(BlockT, (void **) &Block) || !Block ||
+           !plGetNode(DominatedT, (void **) &Dominated) || !Dominated)
+        return pl_warning("dominates/2: both args must be bound");
+      CFGCache &CC = getCompilationInfo()->getCFGCache();
+      return CC.dominates(Block, Dominated) ? TRUE : FALSE;
+    }
+
+    foreign_t pl_cfgReachable(term_t FromT, term_t ToT, control_t Handle) {
+      int Id = -1;
+      switch (PL_foreign_control(Handle)) {
+      case PL_FIRST_CALL:
+        break;
+      case PL_REDO:
+        Id = PL_foreign_context(Handle);
+        break;
+      case PL_PRUNED:
+        return TRUE;
+      }
+      const CFGBlock *From;
+      if ( !plGetNode(FromT, (void **) &From) || !From)
+        return pl_warning("cfgReachable/2: instantiation fault on first arg");
+      CFGCache &CC = getCompilationInfo()->getCFGCache();
+
+      if ( !PL_is_variable(ToT)) {
+        const CFGBlock *To;
+        if ( !plGetNode(ToT, (void **) &To) || !To) return FALSE;
+        return CC.isReachable(From, To) ? TRUE : FALSE;
+      }
+
+      const llvm::BitVector *Reachable = CC.getReachable(From);
+      if ( !Reachable) return FALSE;
+      if (Id < 0) Id = Reachable->find_first();
+      ArrayRef<const CFGBlock*> Blocks = CC.getBlocks(From);
+      if (Id < 0 || !plUnifyNode(ToT, (void *) Blocks[Id])) return FALSE;
+      int Next = Reachable->find_next(Id);
+      if (Next < 0) return TRUE;
+      PL_retry(Next);
+    }
+
+    foreign_t pl_namingViolations(term_t ConventionsT, term_t ViolationsT) {
+      NamingConventions Conventions;
+      term_t HeadT = PL_new_term_ref();
+      term_t RuleT = PL_new_term_ref();
+      term_t SortT = PL_new_term_ref();
+      term_t RegexT = PL_new_term_ref();
+      term_t ListT = PL_copy_term_ref(ConventionsT);
+      while (PL_get_list(ListT, HeadT, ListT)) {
+        atom_t Rule;
+        char *Sort, *Regex;
+        size_t SortLength, RegexLength;
+        if ( !PL_get_arg(1, HeadT, RuleT) || !PL_get_atom(RuleT, &Rule) ||
+             !PL_get_arg(2, HeadT, SortT) ||
+             !PL_get_nchars(SortT, &SortLength, &Sort, CVT_ATOM) ||
+             !PL_get_arg(3, HeadT, RegexT) ||
+             !PL_get_nchars(RegexT, &RegexLength, &Regex,
+                            CVT_ATOM | CVT_STRING | BUF_RING))
+          return pl_warning("namingViolations/2: malformed convention");
+        std::string Error;
+        if ( !Conventions.addConvention(Rule, StringRef(Sort, SortLength),
+                                        StringRef(Regex, RegexLength),
+                                        Error))
+          return pl_warning(Twine("namingViolations/2: ") + Error);
+      }
+      if ( !PL_get_nil(ListT))
+        return pl_warning("namingViolations/2: first arg is not a list");
+
+      std::vector<NamingConventions::Violation> Violations;
+      Conventions.check(getDeclNameIndex()->decls(), Violations);
+
+      functor_t PairF = PL_new_functor(PL_new_atom("-"), 2);
+      term_t TailT = PL_copy_term_ref(ViolationsT);
+      term_t ElemT = PL_new_term_ref();
+      term_t DeclT = PL_new_term_ref();
+      for (std::vector<NamingConventions::Violation>::iterator
+             I = Violations.begin(), E = Violations.end(); I != E; ++I) {
+        PL_put_atom(RuleT, I->first);
+        if ( !plPutNode(DeclT, I->second) ||
+             !PL_cons_functor(ElemT, PairF, RuleT, DeclT) ||
+             !PL_unify_list(TailT, HeadT, TailT) ||
+             !PL_unify(HeadT, ElemT))
+          return FALSE;
+      }
+      return PL_unify_nil(TailT);
+    }
+
     foreign_t pl_reportViolation(term_t RuleT, term_t MsgT, term_t CulpritsT) {
       // FIXME: all 'return FALSE' should be PL_warning'
       const char *Rule;
@@ -105,7 +743,7 @@ namespace crisp {
       // SourceLocation SL;
       // if ( PL_unify_functor(LocT, StmtF)) {
       //   Stmt *S;
-      //   if ( !PL_get_pointer(ElemT, (void **) &S)) return FALSE;
+      //   if ( !plGetNode(ElemT, (void **) &S)) return FALSE;
       //   SL = S->getLocStart();
       // }
       // // FIXME: same for Decl and other elems.
@@ -124,7 +762,7 @@ namespace crisp {
         if ( !PL_get_arg(1, HeadT, ElemT)) return FALSE;
         if ( PL_unify_functor(HeadT, NamedDeclF)) {
           const NamedDecl *ND;
-          if ( !PL_get_pointer(ElemT, (void **) &ND)) return FALSE;
+          if ( !plGetNode(ElemT, (void **) &ND)) return FALSE;
           DB << ND->getDeclName();
           continue;
         }
@@ -144,7 +782,7 @@ namespace crisp {
         if ( !PL_get_atom_chars(MsgT, (char **) &Msg)) return FALSE;
         if ( PL_unify_functor(HeadT, NamedDeclF)) {
           const NamedDecl *ND;
-          if ( !PL_get_pointer(ElemT, (void **) &ND)) return FALSE;
+          if ( !plGetNode(ElemT, (void **) &ND)) return FALSE;
           DiagId = DE.getCustomDiagID(DiagnosticsEngine::Note, Msg);
           DiagnosticBuilder DB = DE.Report(ND->getLocStart(), DiagId);
           DB << ND->getDeclName();
@@ -48,8 +48,13 @@ extern "C" {
 
       /* Automatically generated function declaration. */
 
+#ifdef CRISP_PREDICATE_TABLES
+      /** Registers the predicates of the generated table. */
+      int plRegisterGeneratedPredicates(void);
+#else
 #include "crisp/PrologPredDeclarationMacros.h"
 #include "ClangDeclarations.inc"
+#endif
 
       /* Manual function declaration. */
 
@@ -72,6 +77,215 @@ extern "C" {
       foreign_t pl_getPresumedLoc(term_t DeclT, term_t FilenameT,
                                   term_t LineT, term_t ColT);
 
+      /** Resolves many locations at once; file name atoms are shared
+       *  among calls.
+       *  \param DeclsT +List of Decl
+       *  \param LocsT List of loc(Filename, Line, Col) terms (or
+       *  'unknown' for declarations without a valid location), in the
+       *  same order as DeclsT
+       */
+      foreign_t pl_presumedLocs(term_t DeclsT, term_t LocsT);
+
+      /** Nondeterministic. Enumerates nodes in order of first line.
+       *  \param FileT +Atom, a file name as given by getPresumedLoc/4
+       *  \param FirstLineT +Integer
+       *  \param LastLineT +Integer
+       *  \param NodeT Decl or Stmt whose source range lies completely
+       *  within lines FirstLineT to LastLineT of FileT, as given by
+       *  getPresumedLoc/4 for the expansion locations of its ends
+       */
+      foreign_t pl_nodeInRange(term_t FileT, term_t FirstLineT,
+                               term_t LastLineT, term_t NodeT,
+                               control_t Handle);
+
+      /** \param TypeT +QualType
+       *  \param CanonicalTypeT QualType, canonical type of TypeT
+       */
+      foreign_t pl_canonicalType(term_t TypeT, term_t CanonicalTypeT);
+
+      /** \param TypeT +QualType
+       *  \param DesugaredTypeT QualType, TypeT with sugar removed
+       */
+      foreign_t pl_desugaredType(term_t TypeT, term_t DesugaredTypeT);
+
+      /** Fails if the canonical type of TypeT is not a pointer type.
+       *  \param TypeT +QualType
+       *  \param PointeeT QualType, canonical pointee type
+       */
+      foreign_t pl_canonicalPointee(term_t TypeT, term_t PointeeT);
+
+      /** \param TypeT +QualType
+       *  \param NameT Atom, name of the canonical type of TypeT
+       */
+      foreign_t pl_canonicalTypeName(term_t TypeT, term_t NameT);
+
+      /** Nondeterministic. Enumerates descendants in pre-order.
+       *  \param AncestorT +Stmt
+       *  \param NodeT Stmt, a proper descendant of AncestorT
+       */
+      foreign_t pl_descendant(term_t AncestorT, term_t NodeT,
+                              control_t Handle);
+
+      /** Nondeterministic. Enumerates statements in pre-order (in
+       *  traversal order for the whole translation unit).
+       *  \param ScopeT +Stmt, or the atom 'translationUnit'
+       *  \param ClassT +Atom, name of a concrete statement class
+       *  \param StmtT Stmt of class ClassT in ScopeT (ScopeT included)
+       */
+      foreign_t pl_stmtOfClass(term_t ScopeT, term_t ClassT, term_t StmtT,
+                               control_t Handle);
+
+      /** Fails for roots of statement trees.
+       *  \param NodeT +Stmt
+       *  \param ParentT Stmt
+       */
+      foreign_t pl_parent(term_t NodeT, term_t ParentT);
+
+      /** Nondeterministic. Enumerates ancestors from the parent up.
+       *  \param NodeT +Stmt
+       *  \param AncestorT Stmt, a proper ancestor of NodeT
+       */
+      foreign_t pl_ancestor(term_t NodeT, term_t AncestorT, control_t Handle);
+
+      /** \param NodeT +Stmt
+       *  \param DeclT Decl whose body or initializer contains NodeT
+       */
+      foreign_t pl_enclosingDecl(term_t NodeT, term_t DeclT);
+
+      /** Nondeterministic. Calls are those in the bodies (and
+       *  constructor initializers) of functions in the translation
+       *  unit, with statically known callee.
+       *  \param CallerT +FunctionDecl
+       *  \param CalleeT FunctionDecl (canonical declaration)
+       *  \param KindT one of the atoms 'direct', 'virtual' or 'this'
+       */
+      foreign_t pl_calls(term_t CallerT, term_t CalleeT, term_t KindT,
+                         control_t Handle);
+
+      /** Nondeterministic. Transitive closure of calls/3.
+       *  \param CallerT +FunctionDecl
+       *  \param CalleeT FunctionDecl (canonical declaration)
+       */
+      foreign_t pl_reaches(term_t CallerT, term_t CalleeT, control_t Handle);
+
+      /** Nondeterministic. Transitive closure of calls/3, restricted to
+       *  calls of kind KindT.
+       *  \param CallerT +FunctionDecl
+       *  \param CalleeT FunctionDecl (canonical declaration)
+       *  \param KindT +Atom, 'direct', 'virtual' or 'this'
+       */
+      foreign_t pl_reachesByKind(term_t CallerT, term_t CalleeT, term_t KindT,
+                                 control_t Handle);
+
+      /** Nondeterministic. Transitive closure of base/2.
+       *  \param ClassT +CXXRecordDecl
+       *  \param BaseT CXXRecordDecl (definition), direct or indirect base
+       */
+      foreign_t pl_basePlus(term_t ClassT, term_t BaseT, control_t Handle);
+
+      /** Nondeterministic. Transitive closure of overridden methods.
+       *  \param MethodT +CXXMethodDecl
+       *  \param OverriddenT CXXMethodDecl
+       */
+      foreign_t pl_overridesPlus(term_t MethodT, term_t OverriddenT,
+                                 control_t Handle);
+
+      /** Nondeterministic. Enumerates the vtable slots of ClassT.
+       *  \param ClassT +CXXRecordDecl
+       *  \param MethodT CXXMethodDecl, virtual method of ClassT or a base
+       *  \param OverriderT CXXMethodDecl, final overrider of MethodT in
+       *  ClassT
+       */
+      foreign_t pl_finalOverrider(term_t ClassT, term_t MethodT,
+                                  term_t OverriderT, control_t Handle);
+
+      /** \param ClassT +CXXRecordDecl
+       */
+      foreign_t pl_isPolymorphic(term_t ClassT);
+
+      /** Fails if DeclT is not a NamedDecl.
+       *  \param DeclT +Decl
+       *  \param KeyT Atom, equal for instantiations with the same
+       *  canonical template arguments
+       */
+      foreign_t pl_instantiationKey(term_t DeclT, term_t KeyT);
+
+      /** \param DeclT +Decl, a template pattern or part of one
+       */
+      foreign_t pl_isTemplatePattern(term_t DeclT);
+
+      /** Nondeterministic.
+       *  \param FunctionT FunctionDecl, a definition whose body is the
+       *  first of its class of structurally identical bodies
+       */
+      foreign_t pl_uniqueBody(term_t FunctionT, control_t Handle);
+
+      /** Nondeterministic.
+       *  \param FunctionT +FunctionDecl
+       *  \param CloneT FunctionDecl, a definition with a body
+       *  structurally identical to that of FunctionT (FunctionT
+       *  included)
+       */
+      foreign_t pl_bodyClone(term_t FunctionT, term_t CloneT,
+                             control_t Handle);
+
+      /** \param NodeT +Stmt, ParmVarDecl or local Decl in the body of
+       *  FunctionT (or FunctionT itself)
+       *  \param FunctionT +FunctionDecl
+       *  \param CloneT +FunctionDecl, a clone of FunctionT
+       *  \param CounterpartT node of CloneT in the position of NodeT
+       */
+      foreign_t pl_bodyCounterpart(term_t NodeT, term_t FunctionT,
+                                   term_t CloneT, term_t CounterpartT);
+
+      /** Nondeterministic. Blocks of the CFG of FunctionT (built once
+       *  per function). Fails for functions without body and template
+       *  patterns.
+       *  \param FunctionT +FunctionDecl
+       *  \param BlockT CFGBlock
+       */
+      foreign_t pl_cfgBlock(term_t FunctionT, term_t BlockT, control_t Handle);
+
+      /** \param FunctionT +FunctionDecl
+       *  \param BlockT CFGBlock, entry block of the CFG of FunctionT
+       */
+      foreign_t pl_cfgEntry(term_t FunctionT, term_t BlockT);
+
+      /** \param FunctionT +FunctionDecl
+       *  \param BlockT CFGBlock, exit block of the CFG of FunctionT
+       */
+      foreign_t pl_cfgExit(term_t FunctionT, term_t BlockT);
+
+      /** Nondeterministic.
+       *  \param BlockT +CFGBlock
+       *  \param SuccT CFGBlock, successor of BlockT
+       */
+      foreign_t pl_cfgSucc(term_t BlockT, term_t SuccT, control_t Handle);
+
+      /** Nondeterministic. Enumerates statements in evaluation order.
+       *  \param BlockT +CFGBlock
+       *  \param StmtT Stmt, element of BlockT
+       */
+      foreign_t pl_cfgElement(term_t BlockT, term_t StmtT, control_t Handle);
+
+      /** \param BlockT +CFGBlock
+       *  \param DominatedT +CFGBlock, in the same CFG as BlockT
+       */
+      foreign_t pl_dominates(term_t BlockT, term_t DominatedT);
+
+      /** Nondeterministic.
+       *  \param FromT +CFGBlock
+       *  \param ToT CFGBlock, reachable from FromT through one or more
+       *  edges
+       */
+      foreign_t pl_cfgReachable(term_t FromT, term_t ToT, control_t Handle);
+
+      /** \param ConventionsT +List of naming_convention(Rule, Sort,
+       *  Regex) terms
+       *  \param ViolationsT List of Rule-NamedDecl pairs
+       */
+      foreign_t pl_namingViolations(term_t ConventionsT, term_t ViolationsT);
+
       foreign_t pl_reportViolation(term_t RuleT, term_t MsgT, term_t CulpritsT);
 
 #ifdef __cplusplus
@@ -0,0 +1,74 @@
+// ClangPrologPredicatesShard.cpp ------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+// One shard of the automatically generated function definitions. This
+// file is compiled CRISP_DECL_SHARDS times, with CRISP_DECL_SHARD
+// ranging from 0 to CRISP_DECL_SHARDS - 1. The generated include file
+// assigns every argument class to one shard.
+
+#include <string>
+
+#include "clang/AST/Decl.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclFriend.h"
+// #include "clang/AST/DeclObjC.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/Expr.h"
+#include "clang/AST/Stmt.h"
+#include "clang/AST/StmtCXX.h"
+// #include "clang/AST/StmtObjC.h"
+#include "clang/AST/Type.h"
+
+#include "crisp/PredicateTable.h"
+#include "crisp/PrologPredTemplatesForClangTypes.h"
+#include "CompilationInfo.h"
+#include "ClangPrologPredicates.h"
+#include "RelationInverses.h"
+
+#if !defined(CRISP_DECL_SHARDS) || !defined(CRISP_DECL_SHARD)
+#error "CRISP_DECL_SHARDS and CRISP_DECL_SHARD must be defined"
+#endif
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+#ifdef CRISP_PREDICATE_TABLES
+    namespace {
+#include "crisp/PrologPredTableDefinitionMacros.h"
+#include "ClangDeclarations.inc"
+
+      const PredicateDescriptor ShardPredicates[] = {
+#include "crisp/PrologPredTableMacros.h"
+#include "ClangDeclarations.inc"
+        { 0, 0, 0, 0 }
+      };
+
+      PredicateTableLink ShardLink(ShardPredicates);
+    }
+#else
+#include "crisp/PrologPredDefinitionMacros.h"
+#include "ClangDeclarations.inc"
+#endif
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
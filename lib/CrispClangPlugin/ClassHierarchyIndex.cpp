@@ -0,0 +1,140 @@
+// ClassHierarchyIndex.cpp -------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <set>
+
+#include "clang/AST/CXXInheritance.h"
+#include "llvm/ADT/SmallPtrSet.h"
+
+#include "ClassHierarchyIndex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    template <typename KeyType, typename ListType>
+    static void deleteLists(llvm::DenseMap<KeyType, ListType*> &Map) {
+      for (typename llvm::DenseMap<KeyType, ListType*>::iterator
+             I = Map.begin(), E = Map.end(); I != E; ++I)
+        delete I->second;
+    }
+
+    /// Orders overriders by source location, so that solutions (and
+    /// reports) don't depend on pointer values.
+    class OverriderBefore {
+    public:
+      OverriderBefore(const SourceManager &SM) : SourceManager(SM) {}
+
+      bool operator()(const ClassHierarchyIndex::Overrider &A,
+                      const ClassHierarchyIndex::Overrider &B) const {
+        SourceLocation MethodA = A.first->getLocation();
+        SourceLocation MethodB = B.first->getLocation();
+        if (before(MethodA, MethodB)) return true;
+        if (before(MethodB, MethodA)) return false;
+        return before(A.second->getLocation(), B.second->getLocation());
+      }
+
+    private:
+      bool before(SourceLocation A, SourceLocation B) const {
+        if (A.isInvalid() || B.isInvalid()) return B.isValid();
+        return SourceManager.isBeforeInTranslationUnit(A, B);
+      }
+
+      const SourceManager &SourceManager;
+    };
+
+    ClassHierarchyIndex::~ClassHierarchyIndex() {
+      deleteLists(Bases);
+      deleteLists(OverriddenMethods);
+      deleteLists(FinalOverriders);
+    }
+
+    ArrayRef<const CXXRecordDecl*>
+    ClassHierarchyIndex::getBases(const CXXRecordDecl *RD) {
+      RD = RD->getDefinition();
+      if ( !RD) return ArrayRef<const CXXRecordDecl*>();
+      if (RecordList *Cached = Bases.lookup(RD)) return *Cached;
+
+      RecordList *Result = new RecordList();
+      llvm::SmallPtrSet<const CXXRecordDecl*, 16> Seen;
+      for (CXXRecordDecl::base_class_const_iterator I = RD->bases_begin(),
+             E = RD->bases_end(); I != E; ++I) {
+        // Dependent bases are not known until instantiation
+        const CXXRecordDecl *Base = I->getType()->getAsCXXRecordDecl();
+        if ( !Base || !(Base = Base->getDefinition())) continue;
+        if (Seen.insert(Base)) Result->push_back(Base);
+        ArrayRef<const CXXRecordDecl*> Indirect = getBases(Base);
+        for (unsigned J = 0; J < Indirect.size(); ++J)
+          if (Seen.insert(Indirect[J])) Result->push_back(Indirect[J]);
+      }
+      Bases[RD] = Result;
+      return *Result;
+    }
+
+    ArrayRef<const CXXMethodDecl*>
+    ClassHierarchyIndex::getOverriddenMethods(const CXXMethodDecl *MD) {
+      MD = MD->getCanonicalDecl();
+      if (MethodList *Cached = OverriddenMethods.lookup(MD)) return *Cached;
+
+      MethodList *Result = new MethodList();
+      llvm::SmallPtrSet<const CXXMethodDecl*, 16> Seen;
+      for (CXXMethodDecl::method_iterator I = MD->begin_overridden_methods(),
+             E = MD->end_overridden_methods(); I != E; ++I) {
+        if (Seen.insert(*I)) Result->push_back(*I);
+        ArrayRef<const CXXMethodDecl*> Indirect = getOverriddenMethods(*I);
+        for (unsigned J = 0; J < Indirect.size(); ++J)
+          if (Seen.insert(Indirect[J])) Result->push_back(Indirect[J]);
+      }
+      OverriddenMethods[MD] = Result;
+      return *Result;
+    }
+
+    ArrayRef<ClassHierarchyIndex::Overrider>
+    ClassHierarchyIndex::getFinalOverriders(const CXXRecordDecl *RD) {
+      RD = RD->getDefinition();
+      if ( !RD) return ArrayRef<Overrider>();
+      if (OverriderList *Cached = FinalOverriders.lookup(RD)) return *Cached;
+
+      OverriderList *Result = new OverriderList();
+      if (RD->isPolymorphic() && !RD->isDependentType()) {
+        CXXFinalOverriderMap Map;
+        RD->getFinalOverriders(Map);
+        // The same overrider can be found through several subobjects
+        std::set<Overrider> Seen;
+        for (CXXFinalOverriderMap::iterator M = Map.begin(), ME = Map.end();
+             M != ME; ++M)
+          for (OverridingMethods::iterator S = M->second.begin(),
+                 SE = M->second.end(); S != SE; ++S)
+            for (unsigned J = 0; J < S->second.size(); ++J) {
+              Overrider O(M->first, S->second[J].Method);
+              if (Seen.insert(O).second) Result->push_back(O);
+            }
+        std::stable_sort(Result->begin(), Result->end(),
+                         OverriderBefore(SourceManager));
+      }
+      FinalOverriders[RD] = Result;
+      return *Result;
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
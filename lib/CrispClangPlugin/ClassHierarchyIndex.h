@@ -0,0 +1,87 @@
+// ClassHierarchyIndex.h ---------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Memoized class hierarchy queries.
+
+#ifndef CRISPCLANGPLUGIN_CLASSHIERARCHYINDEX_H
+#define CRISPCLANGPLUGIN_CLASSHIERARCHYINDEX_H
+
+#include <utility>
+#include <vector>
+
+#include "clang/AST/DeclCXX.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Transitive bases, transitively overridden methods and final
+    /// overriders, computed the first time they are asked for a class
+    /// (or method) and kept for the rest of the translation unit.
+    /// Classes are identified by their definitions, methods by their
+    /// canonical declarations.
+    class ClassHierarchyIndex {
+    public:
+      /// A virtual method (a vtable slot of the class) and one of its
+      /// final overriders in the class.
+      typedef std::pair<const CXXMethodDecl*, const CXXMethodDecl*> Overrider;
+
+      ClassHierarchyIndex(const SourceManager &SM) : SourceManager(SM) {}
+
+      ~ClassHierarchyIndex();
+
+      /// Direct and indirect bases of \c RD, without repetitions.
+      llvm::ArrayRef<const CXXRecordDecl*>
+      getBases(const CXXRecordDecl *RD);
+
+      /// Methods directly or indirectly overridden by \c MD.
+      llvm::ArrayRef<const CXXMethodDecl*>
+      getOverriddenMethods(const CXXMethodDecl *MD);
+
+      /// Final overriders of all the virtual methods of \c RD,
+      /// including inherited ones. There can be more than one overrider
+      /// per method if \c RD has several subobjects of the same base.
+      /// Sorted by the source locations of the method and overrider.
+      llvm::ArrayRef<Overrider> getFinalOverriders(const CXXRecordDecl *RD);
+
+    private:
+      typedef std::vector<const CXXRecordDecl*> RecordList;
+      typedef std::vector<const CXXMethodDecl*> MethodList;
+      typedef std::vector<Overrider> OverriderList;
+
+      const SourceManager &SourceManager;
+
+      // Lists are heap allocated, so that they don't move while the
+      // maps grow during recursive computations.
+      llvm::DenseMap<const CXXRecordDecl*, RecordList*> Bases;
+      llvm::DenseMap<const CXXMethodDecl*, MethodList*> OverriddenMethods;
+      llvm::DenseMap<const CXXRecordDecl*, OverriderList*> FinalOverriders;
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
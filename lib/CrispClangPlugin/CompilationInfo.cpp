@@ -38,10 +38,20 @@ namespace crisp {
 
     void deleteCompilationInfo() {
       if (CompilationInfoSingleton) delete CompilationInfoSingleton;
+      CompilationInfoSingleton = 0;
     }
 
     CompilationInfo::~CompilationInfo() {
       delete MangleContext;
+      delete TypeCache;
+      delete StmtIndex;
+      delete ParentIndex;
+      delete CallGraphIndex;
+      delete ClassHierarchyIndex;
+      delete CFGCache;
+      delete SourceLocationIndex;
+      delete BodyCloneIndex;
+      delete DeclContextIndex;
     }
 
   } // End namespace crisp::prolog
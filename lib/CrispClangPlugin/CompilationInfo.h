@@ -28,6 +28,16 @@
 #include "clang/AST/PrettyPrinter.h"
 #include "clang/Frontend/CompilerInstance.h"
 
+#include "BodyCloneIndex.h"
+#include "CallGraphIndex.h"
+#include "CFGCache.h"
+#include "ClassHierarchyIndex.h"
+#include "DeclContextIndex.h"
+#include "ParentIndex.h"
+#include "SourceLocationIndex.h"
+#include "StmtIndex.h"
+#include "TypeCache.h"
+
 using namespace clang;
 
 namespace crisp {
@@ -46,6 +56,24 @@ namespace crisp {
 
       MangleContext* getMangleContext();
 
+      TypeCache& getTypeCache();
+
+      StmtIndex& getStmtIndex();
+
+      ParentIndex& getParentIndex();
+
+      CallGraphIndex& getCallGraphIndex();
+
+      ClassHierarchyIndex& getClassHierarchyIndex();
+
+      CFGCache& getCFGCache();
+
+      SourceLocationIndex& getSourceLocationIndex();
+
+      BodyCloneIndex& getBodyCloneIndex();
+
+      DeclContextIndex& getDeclContextIndex();
+
       friend void newCompilationInfo(CompilerInstance &CI);
       friend void deleteCompilationInfo();
 
@@ -55,7 +83,16 @@ namespace crisp {
         , LangOptions(CI.getLangOpts())
         , PrintingPolicy(LangOptions)
         , SourceManager(CI.getSourceManager())
-        , MangleContext(CI.getASTContext().createMangleContext()) {
+        , MangleContext(CI.getASTContext().createMangleContext())
+        , TypeCache(new class TypeCache(CI.getASTContext(), PrintingPolicy))
+        , ParentIndex(new class ParentIndex())
+        , StmtIndex(new class StmtIndex(*ParentIndex))
+        , CallGraphIndex(new class CallGraphIndex())
+        , ClassHierarchyIndex(new class ClassHierarchyIndex(SourceManager))
+        , CFGCache(new class CFGCache())
+        , SourceLocationIndex(new class SourceLocationIndex(SourceManager))
+        , BodyCloneIndex(new class BodyCloneIndex())
+        , DeclContextIndex(new class DeclContextIndex(CI.getASTContext())) {
       }
 
       ~CompilationInfo();
@@ -65,6 +102,15 @@ namespace crisp {
       const PrintingPolicy PrintingPolicy;
       const SourceManager &SourceManager;
       MangleContext *MangleContext;
+      TypeCache *TypeCache;
+      ParentIndex *ParentIndex;
+      StmtIndex *StmtIndex;
+      CallGraphIndex *CallGraphIndex;
+      ClassHierarchyIndex *ClassHierarchyIndex;
+      CFGCache *CFGCache;
+      SourceLocationIndex *SourceLocationIndex;
+      BodyCloneIndex *BodyCloneIndex;
+      DeclContextIndex *DeclContextIndex;
     };
 
     CompilationInfo* getCompilationInfo();
@@ -94,6 +140,42 @@ namespace crisp {
       return MangleContext;
     }
 
+    inline TypeCache& CompilationInfo::getTypeCache() {
+      return *TypeCache;
+    }
+
+    inline StmtIndex& CompilationInfo::getStmtIndex() {
+      return *StmtIndex;
+    }
+
+    inline ParentIndex& CompilationInfo::getParentIndex() {
+      return *ParentIndex;
+    }
+
+    inline CallGraphIndex& CompilationInfo::getCallGraphIndex() {
+      return *CallGraphIndex;
+    }
+
+    inline ClassHierarchyIndex& CompilationInfo::getClassHierarchyIndex() {
+      return *ClassHierarchyIndex;
+    }
+
+    inline CFGCache& CompilationInfo::getCFGCache() {
+      return *CFGCache;
+    }
+
+    inline SourceLocationIndex& CompilationInfo::getSourceLocationIndex() {
+      return *SourceLocationIndex;
+    }
+
+    inline BodyCloneIndex& CompilationInfo::getBodyCloneIndex() {
+      return *BodyCloneIndex;
+    }
+
+    inline DeclContextIndex& CompilationInfo::getDeclContextIndex() {
+      return *DeclContextIndex;
+    }
+
   } // End namespace crisp::prolog
 
 } // End namespace crisp
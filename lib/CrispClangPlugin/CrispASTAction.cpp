@@ -32,16 +32,27 @@
 #include "clang/AST/RecursiveASTVisitor.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
+#include "clang/CodeGen/BackendUtil.h"
+#include "clang/CodeGen/ModuleBuilder.h"
 #include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/FrontendOptions.h"
 #include "clang/Frontend/FrontendPluginRegistry.h"
+#include "clang/Frontend/MultiplexConsumer.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/LLVMContext.h"
+#include "llvm/Module.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "crisp/ClangPrologQueries.h"
+#include "crisp/DeclNameIndex.h"
+#include "crisp/NodeIdTable.h"
+#include "crisp/PrologUtilityFunctions.h"
 #include "crisp/RunPrologEngine.h"
 #include "ClangPrologPredicateRegistration.h"
 #include "CompilationInfo.h"
+#include "TemplateInstantiations.h"
 
 using namespace llvm;
 using namespace clang;
@@ -56,23 +67,46 @@ namespace crisp {
   class CrispConsumer : public ASTConsumer
                       , public RecursiveASTVisitor<CrispConsumer> {
   public:
-    CrispConsumer(CompilerInstance &CI, std::string &RFN, bool IF, bool DF)
+    CrispConsumer(CompilerInstance &CI, std::string &RFN, bool IF, bool DF,
+                  bool NF, bool SF)
       : CompilerInstance(CI)
       , ErrorInfo()
       , RulesFileName(RFN)
       , InteractiveFlag(IF)
-      , DebugCrispPluginFlag(DF) {
+      , DebugCrispPluginFlag(DF)
+      , NodeIdsFlag(NF)
+      , StringResultsFlag(SF)
+      , VisitInstantiations(false)
+      , EngineRunning(false)
+      , RulesLoaded(false) {
       // ErrorInfo is an output arg to get info about potential errors
       // opening the file/stream.
       FactsOutputStream = new raw_fd_ostream("-", ErrorInfo);
+      // Rules are loaded before parsing, as they determine how much
+      // work the front-end has to do.
+      RulesLoaded = loadRules();
     }
     virtual ~CrispConsumer();
+
+    /// False if rules could not be loaded.
+    bool rulesNeedLLVMIR() const {
+      return RulesLoaded && plRulesNeedLLVMIR();
+    }
+
     virtual void HandleTranslationUnit(ASTContext &Context);
     virtual bool VisitDecl(Decl *D);
+    virtual bool VisitStmt(Stmt *S);
+
+    /// Template instantiations are only traversed if some rule is
+    /// instantiation-level (see rule_level/2).
+    bool shouldVisitTemplateInstantiations() const {
+      return VisitInstantiations;
+    }
 
   private:
     raw_ostream &facts();
     void VisitTypeFromTypesTable(Type *T);
+    bool loadRules();
 
   private:
     CompilerInstance &CompilerInstance;
@@ -81,9 +115,16 @@ namespace crisp {
     std::string RulesFileName;
     bool InteractiveFlag;
     bool DebugCrispPluginFlag;
+    bool NodeIdsFlag;
+    bool StringResultsFlag;
+    bool VisitInstantiations;
+    bool EngineRunning;
+    bool RulesLoaded;
   };
 
   CrispConsumer::~CrispConsumer() {
+    // Translation unit not handled (e.g. because of a fatal error)
+    if (EngineRunning) (void) plCleanUp(1); // Return value ignored
     delete FactsOutputStream;
   }
 
@@ -97,7 +138,7 @@ namespace crisp {
     (void) plAssertTypeIsA(T, Sort); // Return value ignored
   }
 
-  void CrispConsumer::HandleTranslationUnit(ASTContext &Context) {
+  bool CrispConsumer::loadRules() {
 #ifndef NDEBUG
     if ( !DebugFlag && DebugCrispPluginFlag) {
       DebugFlag = 1;
@@ -105,12 +146,11 @@ namespace crisp {
     }
 #endif
 
-    DEBUG(dbgs() << "Handling translation unit." << "\n");
-
     int Success = plRegisterPredicates();
     DEBUG(if ( !Success) dbgs() << "Error registering predicates.\n");
 
     Success = plRunEngine("PrologBootForCrispClangPlugin.sh");
+    EngineRunning = Success;
 
     if (Success) {
       Success = plLoadFile(RulesFileName);
@@ -118,7 +158,40 @@ namespace crisp {
                                   << RulesFileName << "'." << "\n");
     }
 
+    // Function bodies are parsed only if some rule may need them or
+    // if some other consumer (e.g. code generation) does. Clang can
+    // only skip all bodies, not just those in headers.
+    FrontendOptions &FO = CompilerInstance.getFrontendOpts();
+    if (Success && !InteractiveFlag
+        && (FO.ProgramAction == frontend::ParseSyntaxOnly
+            || FO.ProgramAction == frontend::PluginAction)
+        && !plRulesNeedFunctionBodies()) {
+      FO.SkipFunctionBodies = 1;
+      DEBUG(dbgs() << "Function bodies not needed: skipped.\n");
+    }
+
+    return Success;
+  }
+
+  void CrispConsumer::HandleTranslationUnit(ASTContext &Context) {
+    DEBUG(dbgs() << "Handling translation unit." << "\n");
+
+    int Success = RulesLoaded;
+
     if (Success) {
+      // Identify AST nodes by dense integers instead of raw pointers
+      // if user asked so. Identifiers are assigned in traversal order.
+      getNodeIdTable().setEnabled(NodeIdsFlag);
+      plSetStringResults(StringResultsFlag);
+
+      // Set some global data to be accessed from Prolog (var
+      // CompilationInfo defined in CompilationInfo.h). Some of it is
+      // filled while traversing the AST.
+      newCompilationInfo(CompilerInstance);
+
+      // Names are indexed while traversing the AST
+      newDeclNameIndex();
+
       // Get main file name
       SourceManager& SC(Context.getSourceManager());
       FileID MainFileID = SC.getMainFileID();
@@ -131,13 +204,10 @@ namespace crisp {
                   l::bind(&CrispConsumer::VisitTypeFromTypesTable,this,l::_1));
 
       // Traverse AST to visit declarations and statements
+      VisitInstantiations = plNeedsTemplateInstantiations();
       TraverseDecl(Context.getTranslationUnitDecl());
       DEBUG(dbgs() << "Traversing of the AST done!\n");
 
-      // Set some global data to be accessed from Prolog (var
-      // CompilationInfo defined in CompilationInfo.h).
-      newCompilationInfo(CompilerInstance);
-
       // Main Prolog analysis
       Success = plRunTranslationUnitAnalysis(MainFileName);
 
@@ -146,12 +216,15 @@ namespace crisp {
 
       // Free global data
       deleteCompilationInfo();
+      deleteDeclNameIndex();
+      getNodeIdTable().clear();
     }
 
     DEBUG(if (Success) dbgs() << "Translation unit analyzed.\n";
           else dbgs() << "Translation unit analysis aborted: "
                       << "Prolog engine failed.\n";);
     (void) plCleanUp(Success ? 0 : 1); // Return value ignored
+    EngineRunning = false;
 
 #ifndef NDEBUG
     if (DebugFlag) {
@@ -172,8 +245,35 @@ namespace crisp {
     // written instead.
     std::string DeclKindName(D->getDeclKindName());
     std::string Sort(DeclKindName + "Decl");
-    (void) plAssertDeclIsA(D, Sort); // Return value ignored
 
+    // Instantiations are kept apart from the rest of the declarations
+    // (that pattern-level rules see through isA/2 and by name), even
+    // if no rule needs them, so that pattern-level rules give the same
+    // results whatever other rules are loaded.
+    if (isInstantiated(D)) {
+      if (VisitInstantiations)
+        (void) plAssertInstantiationIsA(D, Sort); // Return value ignored
+    } else {
+      (void) plAssertDeclIsA(D, Sort); // Return value ignored
+      if (NamedDecl *ND = dyn_cast<NamedDecl>(D))
+        getDeclNameIndex()->addDecl(ND);
+    }
+    getCompilationInfo()->getParentIndex().addDecl(D);
+    getCompilationInfo()->getCallGraphIndex().addDecl(D);
+    getCompilationInfo()->getSourceLocationIndex().addDecl(D);
+    getCompilationInfo()->getBodyCloneIndex().addDecl(D);
+
+    return true;
+  }
+
+  bool CrispConsumer::VisitStmt(Stmt *S) {
+    // Statements are not asserted as facts, but in ID mode they get
+    // their identifier during traversal (as declarations do, when
+    // asserted), so that their identifiers don't depend on rule
+    // evaluation order. Types get theirs when first unified.
+    if (getNodeIdTable().isEnabled()) (void) getNodeIdTable().getId(S);
+    getCompilationInfo()->getStmtIndex().addStmt(S);
+    getCompilationInfo()->getSourceLocationIndex().addStmt(S);
     return true;
   }
 
@@ -185,20 +285,32 @@ namespace crisp {
 
   class CrispASTAction : public PluginASTAction {
   public:
-    CrispASTAction() : InteractiveFlag(false), DebugCrispPluginFlag(false) {}
+    CrispASTAction()
+      : InteractiveFlag(false)
+      , DebugCrispPluginFlag(false)
+      , NodeIdsFlag(false)
+      , StringResultsFlag(false) {}
 
   protected:
     virtual ASTConsumer* CreateASTConsumer(CompilerInstance &CI, StringRef) {
+      return createCrispConsumer(CI);
+    }
+
+    CrispConsumer *createCrispConsumer(CompilerInstance &CI) {
       return new CrispConsumer(CI, RulesFileName, InteractiveFlag,
-                               DebugCrispPluginFlag);
+                               DebugCrispPluginFlag, NodeIdsFlag,
+                               StringResultsFlag);
     }
 
     virtual bool ParseArgs(const CompilerInstance &CI,
                            const std::vector<std::string> &Args);
-  private:
+  protected:
     std::string RulesFileName;
     bool InteractiveFlag;
     bool DebugCrispPluginFlag;
+    bool NodeIdsFlag;
+    bool StringResultsFlag;
+  private:
     bool parseOneArg(const std::string &);
   };
 
@@ -231,6 +343,14 @@ namespace crisp {
         DebugCrispPluginFlag = true;
         return true;
       }
+      if (Arg.compare("-node-ids") == 0) {
+        NodeIdsFlag = true;
+        return true;
+      }
+      if (Arg.compare("-string-results") == 0) {
+        StringResultsFlag = true;
+        return true;
+      }
       return false;                        // else: unknown option argument
     }                                      // else: input argument
     if ( !RulesFileName.empty()) {         // Rules file already set
@@ -240,7 +360,60 @@ namespace crisp {
     return true;
   }
 
+  /// Main action for rule checking. Unlike \c crisp-clang, that is
+  /// meant to be added to a compilation, \c crisp-check does
+  /// nothing but parsing and rule evaluation, unless some loaded rule
+  /// is checked on LLVM IR: in that case it also generates the IR
+  /// (as \c -emit-llvm does, into the same \c .ll file) and the
+  /// candidates file the Crisp LLVM pass needs.
+  class CrispCheckAction : public CrispASTAction {
+  public:
+    CrispCheckAction() : CodeGen(0), IROutputStream(0) {}
+
+  protected:
+    virtual ASTConsumer* CreateASTConsumer(CompilerInstance &CI,
+                                           StringRef InFile);
+    virtual void EndSourceFileAction();
+
+  private:
+    OwningPtr<LLVMContext> VMContext;
+    CodeGenerator *CodeGen;             // Owned by the MultiplexConsumer
+    raw_ostream *IROutputStream;        // Owned by the CompilerInstance
+  };
+
+  ASTConsumer* CrispCheckAction::CreateASTConsumer(CompilerInstance &CI,
+                                                   StringRef InFile) {
+    CodeGen = 0;
+    // Rules are loaded at consumer creation
+    CrispConsumer *Crisp = createCrispConsumer(CI);
+    if ( !Crisp->rulesNeedLLVMIR()) return Crisp;
+
+    IROutputStream = CI.createDefaultOutputFile(false, InFile, "ll");
+    if ( !IROutputStream) return Crisp;
+    VMContext.reset(new LLVMContext());
+    CodeGen = CreateLLVMCodeGen(CI.getDiagnostics(), InFile,
+                                CI.getCodeGenOpts(), *VMContext);
+    std::vector<ASTConsumer*> Consumers;
+    Consumers.push_back(Crisp);
+    Consumers.push_back(CodeGen);
+    return new MultiplexConsumer(Consumers);
+  }
+
+  void CrispCheckAction::EndSourceFileAction() {
+    if ( !CodeGen) return;
+    OwningPtr<llvm::Module> TheModule(CodeGen->ReleaseModule());
+    CompilerInstance &CI = getCompilerInstance();
+    if ( !TheModule || CI.getDiagnostics().hasErrorOccurred()) return;
+    // The same passes -emit-llvm runs, so that the IR is the same
+    EmitBackendOutput(CI.getDiagnostics(), CI.getCodeGenOpts(),
+                      CI.getTargetOpts(), CI.getLangOpts(), TheModule.get(),
+                      Backend_EmitLL, IROutputStream);
+  }
+
   static FrontendPluginRegistry::Add<CrispASTAction>
   X("crisp-clang", "Data extraction clang plugin for CRISP");
 
+  static FrontendPluginRegistry::Add<CrispCheckAction>
+  Y("crisp-check", "CRISP rule checking, generating LLVM IR only if needed");
+
 } // End namespace crisp
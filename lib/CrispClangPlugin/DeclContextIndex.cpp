@@ -0,0 +1,81 @@
+// DeclContextIndex.cpp ----------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <vector>
+
+#include "clang/AST/Decl.h"
+#include "clang/AST/DeclTemplate.h"
+
+#include "DeclContextIndex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    void DeclContextIndex::add(const Decl *D) {
+      const DeclContext *DC = D->getDeclContext();
+      Decls[Decl::castFromDeclContext(DC)].push_back(D);
+      Contexts[D] = DC;
+    }
+
+    void DeclContextIndex::build() {
+      std::vector<const DeclContext*> Pending;
+      Pending.push_back(Context.getTranslationUnitDecl());
+      while ( !Pending.empty()) {
+        const DeclContext *DC = Pending.back();
+        Pending.pop_back();
+        for (DeclContext::decl_iterator I = DC->decls_begin(),
+               E = DC->decls_end(); I != E; ++I) {
+          const Decl *D = *I;
+          add(D);
+          if (const DeclContext *Inner = dyn_cast<DeclContext>(D))
+            Pending.push_back(Inner);
+          // Templated declarations are not in the context's list, and
+          // members of templates are in the templated declaration
+          else if (const TemplateDecl *TD = dyn_cast<TemplateDecl>(D))
+            if (const Decl *Templated = TD->getTemplatedDecl()) {
+              add(Templated);
+              if (const DeclContext *Pattern
+                  = dyn_cast<DeclContext>(Templated))
+                Pending.push_back(Pattern);
+            }
+        }
+      }
+      Built = true;
+    }
+
+    llvm::ArrayRef<const void*>
+    DeclContextIndex::getDecls(const void *Node) {
+      if ( !Built) build();
+      llvm::DenseMap<const void*, DeclList>::const_iterator I
+        = Decls.find(Node);
+      if (I == Decls.end()) return llvm::ArrayRef<const void*>();
+      return I->second;
+    }
+
+    const DeclContext *DeclContextIndex::getContext(const void *Node) {
+      if ( !Built) build();
+      return Contexts.lookup(Node);
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
@@ -0,0 +1,75 @@
+// DeclContextIndex.h ------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Declarations grouped by their semantic context.
+
+#ifndef CRISPCLANGPLUGIN_DECLCONTEXTINDEX_H
+#define CRISPCLANGPLUGIN_DECLCONTEXTINDEX_H
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclBase.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Inverse of \c Decl::getDeclContext(). Out-of-line members are
+    /// found under their class, not under the context where they are
+    /// written. The index is built the first time it is used, walking
+    /// all the declaration contexts from the translation unit down.
+    /// Nodes are looked up by address only, so they can be of any
+    /// kind: nodes that are not indexed declarations are not found.
+    class DeclContextIndex {
+    public:
+      DeclContextIndex(const ASTContext &Context)
+        : Context(Context), Built(false) {
+      }
+
+      /// Returns the declarations whose semantic context is the
+      /// declaration \c Node.
+      llvm::ArrayRef<const void*> getDecls(const void *Node);
+
+      /// Returns the semantic context of the declaration \c Node, or
+      /// null if \c Node is not an indexed declaration.
+      const DeclContext *getContext(const void *Node);
+
+    private:
+      typedef llvm::SmallVector<const void*, 4> DeclList;
+
+      void build();
+
+      void add(const Decl *D);
+
+      const ASTContext &Context;
+      llvm::DenseMap<const void*, DeclList> Decls;
+      llvm::DenseMap<const void*, const DeclContext*> Contexts;
+      bool Built;
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
@@ -0,0 +1,148 @@
+// NamingConventions.cpp ---------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstring>
+
+#include "clang/AST/ASTContext.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/StringSwitch.h"
+
+#include "NamingConventions.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    typedef std::pair<unsigned, unsigned> KindRange;
+
+    /// Concrete classes stand only for themselves, as in isA/2 facts;
+    /// abstract ones stand for all their heirs.
+    static KindRange getKindRange(StringRef Sort) {
+      return llvm::StringSwitch<KindRange>(Sort)
+#define DECL(DERIVED, BASE)                                             \
+        .Case(#DERIVED "Decl", KindRange(Decl::DERIVED, Decl::DERIVED))
+#define ABSTRACT_DECL(DECL)
+#define DECL_RANGE(BASE, START, END)                                    \
+        .Case(#BASE "Decl", KindRange(Decl::START, Decl::END))
+#include "clang/AST/DeclNodes.inc"
+        .Default(KindRange(1, 0));           // Empty range
+    }
+
+    static inline bool isRegexMetachar(char C) {
+      return C && std::strchr(".[]()*+?{}|\\^$", C);
+    }
+
+    /// Computes literals that every string matching \c Regex must
+    /// start and end with. They are conservative: empty when unsure.
+    static void getLiteralAffixes(StringRef Regex,
+                                  std::string &Prefix, std::string &Suffix,
+                                  bool &AffixesSuffice) {
+      Prefix.clear();
+      Suffix.clear();
+      AffixesSuffice = false;
+      if (Regex.find('|') != StringRef::npos) return;
+
+      size_t Size = Regex.size();
+      if (Regex.startswith("^")) {
+        size_t I = 1;
+        while (I < Size && !isRegexMetachar(Regex[I])) ++I;
+        size_t End = I;
+        // Last literal char is optional if followed by one of these
+        if (I < Size && std::strchr("*?{", Regex[I])) --End;
+        Prefix = Regex.slice(1, End).str();
+        AffixesSuffice = (I == Size);         // Regex is just '^Prefix'
+      }
+
+      if (Regex.endswith("$") && !Regex.endswith("\\$")) {
+        size_t J = Size - 1;
+        while (J > 0 && !isRegexMetachar(Regex[J - 1])) --J;
+        if (J > 0 && Regex[J - 1] == '\\') ++J; // Skip escaped char
+        Suffix = Regex.slice(J, Size - 1).str();
+        AffixesSuffice = (J == 0);            // Regex is just 'Suffix$'
+      }
+    }
+
+    NamingConventions::~NamingConventions() {
+      for (std::vector<Convention>::iterator I = Conventions.begin(),
+             E = Conventions.end(); I != E; ++I)
+        delete I->Regex;
+    }
+
+    bool NamingConventions::addConvention(atom_t Rule, StringRef Sort,
+                                          StringRef Regex,
+                                          std::string &Error) {
+      Convention C;
+      C.Rule = Rule;
+      KindRange Range = getKindRange(Sort);
+      if (Range.first > Range.second) {
+        Error = "unknown declaration sort '" + Sort.str() + "'";
+        return false;
+      }
+      C.FirstKind = Range.first;
+      C.LastKind = Range.second;
+      C.Regex = new llvm::Regex(Regex);
+      if ( !C.Regex->isValid(Error)) {
+        delete C.Regex;
+        return false;
+      }
+      getLiteralAffixes(Regex, C.Prefix, C.Suffix, C.AffixesSuffice);
+      Conventions.push_back(C);
+      return true;
+    }
+
+    bool NamingConventions::follows(const Convention &C,
+                                    StringRef Name) const {
+      // Cheap literal comparisons rule out most offending names
+      // before the regex engine is run.
+      if ( !Name.startswith(C.Prefix) || !Name.endswith(C.Suffix))
+        return false;
+      if (C.AffixesSuffice) return true;
+      return C.Regex->match(Name);
+    }
+
+    void NamingConventions::check(ArrayRef<const NamedDecl*> Decls,
+                                  std::vector<Violation> &Violations) const {
+      if (Conventions.empty()) return;
+      for (ArrayRef<const NamedDecl*>::iterator I = Decls.begin(),
+             E = Decls.end(); I != E; ++I) {
+        const NamedDecl *D = *I;
+        const IdentifierInfo *II = D->getIdentifier();
+        if ( !II) continue;
+        unsigned Kind = D->getKind();
+        bool InSystemHeader = false, LocationChecked = false;
+        for (std::vector<Convention>::const_iterator C = Conventions.begin(),
+               CE = Conventions.end(); C != CE; ++C) {
+          if (Kind < C->FirstKind || Kind > C->LastKind) continue;
+          if ( !LocationChecked) {
+            const SourceManager &SM = D->getASTContext().getSourceManager();
+            InSystemHeader = SM.isInSystemHeader(D->getLocation());
+            LocationChecked = true;
+          }
+          if (InSystemHeader) break;
+          if ( !follows(*C, II->getName()))
+            Violations.push_back(Violation(C->Rule, D));
+        }
+      }
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
@@ -0,0 +1,85 @@
+// NamingConventions.h -----------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Bulk checking of naming conventions.
+
+#ifndef CRISPCLANGPLUGIN_NAMINGCONVENTIONS_H
+#define CRISPCLANGPLUGIN_NAMINGCONVENTIONS_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <SWI-Prolog.h>
+
+#include "clang/AST/Decl.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/Regex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// A set of naming conventions, each one stating that the names
+    /// of all declarations of some sort must match a regular
+    /// expression. Regular expressions are compiled once, and all the
+    /// conventions are checked in a single pass over the declarations.
+    class NamingConventions {
+    public:
+      typedef std::pair<atom_t, const NamedDecl*> Violation;
+
+      ~NamingConventions();
+
+      /// \c Sort is the name of a declaration class, as used in \c
+      /// isA/2 facts (e.g. 'CXXMethodDecl'), or of an abstract one
+      /// (e.g. 'ValueDecl'), that stands for all its heirs. Returns
+      /// false and sets \c Error if \c Sort or \c Regex is invalid.
+      bool addConvention(atom_t Rule, StringRef Sort, StringRef Regex,
+                         std::string &Error);
+
+      /// Appends to \c Violations a (Rule, Decl) pair for every
+      /// declaration in \c Decls whose name does not follow the
+      /// convention of Rule. Declarations in system headers and
+      /// without a plain identifier as name are ignored.
+      void check(llvm::ArrayRef<const NamedDecl*> Decls,
+                 std::vector<Violation> &Violations) const;
+
+    private:
+      struct Convention {
+        atom_t Rule;
+        unsigned FirstKind, LastKind;
+        // Literals every matching name starts/ends with
+        std::string Prefix, Suffix;
+        // True if matching Prefix and Suffix implies matching Regex
+        bool AffixesSuffice;
+        llvm::Regex *Regex;
+      };
+
+      bool follows(const Convention &C, StringRef Name) const;
+
+      std::vector<Convention> Conventions;
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
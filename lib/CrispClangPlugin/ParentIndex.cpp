@@ -0,0 +1,80 @@
+// ParentIndex.cpp ---------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "clang/AST/DeclCXX.h"
+
+#include "ParentIndex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    ParentIndex::~ParentIndex() {
+      delete Map;
+    }
+
+    void ParentIndex::addRoot(const Stmt *S, const Decl *Owner) {
+      if ( !S) return;
+      Roots.push_back(const_cast<Stmt*>(S));
+      Owners[S] = Owner;
+    }
+
+    void ParentIndex::addDecl(const Decl *D) {
+      if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D)) {
+        if (FD->doesThisDeclarationHaveABody()) addRoot(FD->getBody(), D);
+        if (const CXXConstructorDecl *CD = dyn_cast<CXXConstructorDecl>(FD))
+          for (CXXConstructorDecl::init_const_iterator
+                 I = CD->init_begin(), E = CD->init_end(); I != E; ++I)
+            addRoot((*I)->getInit(), D);
+      } else if (const VarDecl *VD = dyn_cast<VarDecl>(D)) {
+        // Initializers of local variables are already in a body
+        if ( !VD->isLocalVarDecl()) addRoot(VD->getInit(), D);
+      }
+    }
+
+    ParentMap *ParentIndex::getMap() {
+      if (Roots.empty()) return 0;
+      if ( !Map) {
+        Map = new ParentMap(Roots[0]);
+        NumMapped = 1;
+      }
+      for (; NumMapped < Roots.size(); ++NumMapped)
+        Map->addStmt(Roots[NumMapped]);
+      return Map;
+    }
+
+    const Stmt *ParentIndex::getParent(const Stmt *S) {
+      ParentMap *PM = getMap();
+      if ( !PM) return 0;
+      return PM->getParent(const_cast<Stmt*>(S));
+    }
+
+    const Decl *ParentIndex::getEnclosingDecl(const Stmt *S) {
+      ParentMap *PM = getMap();
+      if ( !PM) return 0;
+      Stmt *Current = const_cast<Stmt*>(S);
+      while (Stmt *Parent = PM->getParent(Current)) Current = Parent;
+      return Owners.lookup(Current);
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
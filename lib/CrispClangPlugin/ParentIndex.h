@@ -0,0 +1,76 @@
+// ParentIndex.h -----------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Upward navigation from statements.
+
+#ifndef CRISPCLANGPLUGIN_PARENTINDEX_H
+#define CRISPCLANGPLUGIN_PARENTINDEX_H
+
+#include <vector>
+
+#include "clang/AST/Decl.h"
+#include "clang/AST/ParentMap.h"
+#include "clang/AST/Stmt.h"
+#include "llvm/ADT/DenseMap.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Parents of all the statements in the translation unit. The
+    /// roots of statement trees (function bodies, constructor
+    /// initializers, initializers of non-local variables) and their
+    /// owning declarations are recorded during AST traversal; the
+    /// underlying \c ParentMap is only built when first needed.
+    class ParentIndex {
+    public:
+      ParentIndex() : Map(0), NumMapped(0) {}
+
+      ~ParentIndex();
+
+      /// To be called during AST traversal.
+      void addDecl(const Decl *D);
+
+      /// Returns null for roots.
+      const Stmt *getParent(const Stmt *S);
+
+      /// Returns the declaration that owns the tree \c S is in, or null
+      /// if \c S is not in any recorded tree.
+      const Decl *getEnclosingDecl(const Stmt *S);
+
+    private:
+      void addRoot(const Stmt *S, const Decl *Owner);
+
+      /// Returns null if no tree has been recorded.
+      ParentMap *getMap();
+
+      std::vector<Stmt*> Roots;
+      llvm::DenseMap<const Stmt*, const Decl*> Owners;
+      ParentMap *Map;
+      unsigned NumMapped;                     // Prefix of Roots in Map
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
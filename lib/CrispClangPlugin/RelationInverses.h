@@ -0,0 +1,48 @@
+// RelationInverses.h ------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Inverses of the generated relations that are reversible
+/// (see reversibleRelation/2 in the DeclExtractor boot file). The
+/// node passed can be of any kind: if it is not of the expected one
+/// there is no result (null or empty).
+
+#ifndef CRISPCLANGPLUGIN_RELATIONINVERSES_H
+#define CRISPCLANGPLUGIN_RELATIONINVERSES_H
+
+#include "llvm/ADT/ArrayRef.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// The record declaring a method.
+    const void *inverse_CXXRecordDecl_method(const void *Node);
+
+    /// The parent of a statement.
+    const void *inverse_Stmt_child(const void *Node);
+
+    /// The declarations whose context is a given one.
+    llvm::ArrayRef<const void*> inverse_Decl_declContext(const void *Node);
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
@@ -0,0 +1,94 @@
+// SourceLocationIndex.cpp -------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstring>
+
+#include "SourceLocationIndex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    SourceLocationIndex::~SourceLocationIndex() {
+      for (llvm::DenseMap<const char*, atom_t>::iterator
+             I = FileNameAtoms.begin(), E = FileNameAtoms.end(); I != E; ++I)
+        PL_unregister_atom(I->second);
+    }
+
+    atom_t SourceLocationIndex::getFileNameAtom(const char *FileName) {
+      // File name buffers are owned by the SourceManager (or the
+      // FileManager), so their addresses identify them.
+      atom_t &Entry = FileNameAtoms[FileName];
+      if ( !Entry) Entry = PL_new_atom(FileName);
+      return Entry;
+    }
+
+    void SourceLocationIndex::add(const void *Node, SourceRange Range) {
+      SourceLocation Begin = Range.getBegin(), End = Range.getEnd();
+      if (Begin.isInvalid() || End.isInvalid()) return;
+      PresumedLoc PBegin
+        = SourceManager.getPresumedLoc(SourceManager.getExpansionLoc(Begin));
+      PresumedLoc PEnd
+        = SourceManager.getPresumedLoc(SourceManager.getExpansionLoc(End));
+      if (PBegin.isInvalid() || PEnd.isInvalid()) return;
+      if (std::strcmp(PBegin.getFilename(), PEnd.getFilename()) != 0) return;
+
+      // Different inclusions of a file share the same list
+      Entry NewEntry = { PBegin.getLine(), PEnd.getLine(), Node };
+      Files[PBegin.getFilename()].push_back(NewEntry);
+    }
+
+    void SourceLocationIndex::build() {
+      Built = true;
+      for (unsigned I = 0; I < Decls.size(); ++I)
+        add(Decls[I], Decls[I]->getSourceRange());
+      for (unsigned I = 0; I < Stmts.size(); ++I)
+        add(Stmts[I], Stmts[I]->getSourceRange());
+      for (llvm::StringMap<EntryList>::iterator I = Files.begin(),
+             E = Files.end(); I != E; ++I)
+        std::stable_sort(I->getValue().begin(), I->getValue().end());
+      Decls.clear();
+      Stmts.clear();
+    }
+
+    const void *SourceLocationIndex::getNextInRange(StringRef File,
+                                                    unsigned FirstLine,
+                                                    unsigned LastLine,
+                                                    unsigned &Pos) {
+      if ( !Built) build();
+      llvm::StringMap<EntryList>::iterator I = Files.find(File);
+      if (I == Files.end()) return 0;
+      const EntryList &List = I->getValue();
+
+      Entry Key = { FirstLine, 0, 0 };
+      unsigned First = std::lower_bound(List.begin(), List.end(), Key)
+        - List.begin();
+      // Nodes are sorted by first line, but not by last one
+      for (Pos = std::max(Pos, First);
+           Pos < List.size() && List[Pos].FirstLine <= LastLine; ++Pos)
+        if (List[Pos].LastLine <= LastLine) return List[Pos].Node;
+      return 0;
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
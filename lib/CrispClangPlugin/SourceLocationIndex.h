@@ -0,0 +1,105 @@
+// SourceLocationIndex.h ---------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Location-scoped queries and cached file name atoms.
+
+#ifndef CRISPCLANGPLUGIN_SOURCELOCATIONINDEX_H
+#define CRISPCLANGPLUGIN_SOURCELOCATIONINDEX_H
+
+#include <vector>
+#include <SWI-Prolog.h>
+
+#include "clang/AST/Decl.h"
+#include "clang/AST/Stmt.h"
+#include "clang/Basic/SourceManager.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Line ranges of the declarations and statements in the
+    /// translation unit, per file. Nodes are recorded during AST
+    /// traversal; their line ranges are computed, and sorted by first
+    /// line per file, the first time a query is made. Files and lines
+    /// are presumed ones (honoring \#line directives and line
+    /// markers) of expansion locations, as given by getPresumedLoc/4.
+    ///
+    /// Also caches the atoms of file names, so that they are created
+    /// only once per file however many locations are resolved.
+    class SourceLocationIndex {
+    public:
+      SourceLocationIndex(const SourceManager &SM)
+        : SourceManager(SM), Built(false) {
+      }
+
+      ~SourceLocationIndex();
+
+      /// To be called during AST traversal.
+      void addDecl(const Decl *D) {
+        Decls.push_back(D);
+      }
+
+      /// To be called during AST traversal.
+      void addStmt(const Stmt *S) {
+        Stmts.push_back(S);
+      }
+
+      /// Returns the first node, at position \c Pos or later in an
+      /// internal order, that lies completely within lines \c
+      /// FirstLine to \c LastLine of presumed file \c File, and sets
+      /// \c Pos to its position. Returns null if there is no such node.
+      const void *getNextInRange(StringRef File, unsigned FirstLine,
+                                 unsigned LastLine, unsigned &Pos);
+
+      /// Returns a (registered) atom for \c FileName, a file name as
+      /// returned by \c PresumedLoc::getFilename().
+      atom_t getFileNameAtom(const char *FileName);
+
+    private:
+      struct Entry {
+        unsigned FirstLine, LastLine;
+        const void *Node;
+        bool operator<(const Entry &Other) const {
+          return FirstLine < Other.FirstLine;
+        }
+      };
+      typedef std::vector<Entry> EntryList;
+
+      void build();
+
+      void add(const void *Node, SourceRange Range);
+
+      const SourceManager &SourceManager;
+      bool Built;
+      std::vector<const Decl*> Decls;
+      std::vector<const Stmt*> Stmts;
+      llvm::StringMap<EntryList> Files;
+      llvm::DenseMap<const char*, atom_t> FileNameAtoms;
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
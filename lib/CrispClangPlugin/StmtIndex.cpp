@@ -0,0 +1,115 @@
+// StmtIndex.cpp -----------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+
+#include "llvm/ADT/StringSwitch.h"
+
+#include "StmtIndex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    StmtIndex::StmtIndex(ParentIndex &Parents)
+      : Parents(Parents)
+      , StmtsByClass(Stmt::lastStmtConstant + 1)
+      , PositionsByClass(Stmt::lastStmtConstant + 1)
+      , TUStmtsByClass(Stmt::lastStmtConstant + 1) {
+    }
+
+    // Whole trees are numbered, from their root, so every statement
+    // is numbered once. Only statements out of the trees recorded by
+    // the ParentIndex can be numbered again, as part of a bigger tree
+    // asked about later; then their old slots are cleared.
+    const StmtIndex::Interval &StmtIndex::getInterval(const Stmt *S) {
+      llvm::DenseMap<const Stmt*, Interval>::iterator I = Intervals.find(S);
+      if (I != Intervals.end()) return I->second;
+      const Stmt *Root = S;
+      while (const Stmt *Parent = Parents.getParent(Root)) Root = Parent;
+      number(Root);
+      return Intervals[S];
+    }
+
+    void StmtIndex::number(const Stmt *S) {
+      llvm::DenseMap<const Stmt*, Interval>::iterator I = Intervals.find(S);
+      if (I != Intervals.end()) clear(I->second);
+      unsigned Begin = PreOrder.size();
+      PreOrder.push_back(S);
+      // Positions are pushed in increasing order, so buckets are sorted
+      StmtsByClass[S->getStmtClass()].push_back(S);
+      PositionsByClass[S->getStmtClass()].push_back(Begin);
+      for (Stmt::child_range C = const_cast<Stmt*>(S)->children(); C; ++C)
+        if (*C) number(*C);                   // Children can be null
+      Intervals[S] = Interval(Begin, PreOrder.size());
+    }
+
+    // Null slots are skipped by getManyFromArray().
+    void StmtIndex::clear(const Interval &Stale) {
+      for (unsigned Pos = Stale.first; Pos < Stale.second; ++Pos) {
+        const Stmt *S = PreOrder[Pos];
+        if ( !S) continue;                    // Already cleared
+        const std::vector<unsigned> &Positions
+          = PositionsByClass[S->getStmtClass()];
+        unsigned K = std::lower_bound(Positions.begin(), Positions.end(),
+                                      Pos) - Positions.begin();
+        StmtsByClass[S->getStmtClass()][K] = 0;
+        PreOrder[Pos] = 0;
+      }
+    }
+
+    bool StmtIndex::isDescendant(const Stmt *Ancestor, const Stmt *Node) {
+      Interval A = getInterval(Ancestor);
+      llvm::DenseMap<const Stmt*, Interval>::iterator I = Intervals.find(Node);
+      if (I == Intervals.end()) return false;
+      return A.first < I->second.first && I->second.first < A.second;
+    }
+
+    ArrayRef<const Stmt*> StmtIndex::getDescendants(const Stmt *S) {
+      Interval A = getInterval(S);
+      return ArrayRef<const Stmt*>(PreOrder).slice(A.first + 1,
+                                                  A.second - A.first - 1);
+    }
+
+    ArrayRef<const Stmt*> StmtIndex::getStmtsOfClass(const Stmt *Scope,
+                                                     Stmt::StmtClass Class) {
+      Interval A = getInterval(Scope);
+      const std::vector<unsigned> &Positions = PositionsByClass[Class];
+      unsigned First = std::lower_bound(Positions.begin(), Positions.end(),
+                                        A.first) - Positions.begin();
+      unsigned Last = std::lower_bound(Positions.begin() + First,
+                                       Positions.end(),
+                                       A.second) - Positions.begin();
+      return ArrayRef<const Stmt*>(StmtsByClass[Class]).slice(First,
+                                                             Last - First);
+    }
+
+    Stmt::StmtClass getStmtClassByName(StringRef Name) {
+      return llvm::StringSwitch<Stmt::StmtClass>(Name)
+#define STMT(CLASS, PARENT) .Case(#CLASS, Stmt::CLASS##Class)
+#define ABSTRACT_STMT(STMT)
+#include "clang/AST/StmtNodes.inc"
+        .Default(Stmt::NoStmtClass);
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
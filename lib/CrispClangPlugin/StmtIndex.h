@@ -0,0 +1,107 @@
+// StmtIndex.h -------------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Interval index over statement trees.
+
+#ifndef CRISPCLANGPLUGIN_STMTINDEX_H
+#define CRISPCLANGPLUGIN_STMTINDEX_H
+
+#include <utility>
+#include <vector>
+
+#include "clang/AST/Stmt.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include "ParentIndex.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Pre-order numbering of statement trees. The first time a
+    /// statement not yet numbered is asked about, the whole tree it
+    /// belongs to (found through the \c ParentIndex) is appended, in
+    /// pre-order, to a flat array, and every node in it gets the
+    /// interval of array positions its subtree spans. Then
+    /// descendant tests are two lookups and a comparison, and the
+    /// descendants of a node are a contiguous slice of the array.
+    ///
+    /// Numbered statements are also bucketed by \c StmtClass, keeping
+    /// their positions, so the statements of some class in a subtree
+    /// are a contiguous slice of the bucket too. A second set of
+    /// buckets holds all the statements in the translation unit.
+    class StmtIndex {
+    public:
+      explicit StmtIndex(ParentIndex &Parents);
+
+      /// To be called during AST traversal.
+      void addStmt(const Stmt *S) {
+        TUStmtsByClass[S->getStmtClass()].push_back(S);
+      }
+
+      /// True if \c Node is a proper descendant of \c Ancestor.
+      bool isDescendant(const Stmt *Ancestor, const Stmt *Node);
+
+      /// Proper descendants of \c S, in pre-order. The result is
+      /// invalidated by subsequent calls to this object.
+      llvm::ArrayRef<const Stmt*> getDescendants(const Stmt *S);
+
+      /// Statements of class \c Class in the subtree rooted at \c
+      /// Scope (\c Scope included), in pre-order. The result is
+      /// invalidated by subsequent calls to this object.
+      llvm::ArrayRef<const Stmt*> getStmtsOfClass(const Stmt *Scope,
+                                                  Stmt::StmtClass Class);
+
+      /// Statements of class \c Class in the translation unit, in
+      /// traversal order.
+      llvm::ArrayRef<const Stmt*>
+      getStmtsOfClass(Stmt::StmtClass Class) const {
+        return TUStmtsByClass[Class];
+      }
+
+    private:
+      typedef std::pair<unsigned, unsigned> Interval;
+
+      const Interval &getInterval(const Stmt *S);
+
+      void number(const Stmt *S);
+
+      void clear(const Interval &Stale);
+
+      ParentIndex &Parents;
+      std::vector<const Stmt*> PreOrder;
+      llvm::DenseMap<const Stmt*, Interval> Intervals;
+      std::vector< std::vector<const Stmt*> > StmtsByClass;
+      std::vector< std::vector<unsigned> > PositionsByClass;
+      std::vector< std::vector<const Stmt*> > TUStmtsByClass;
+    };
+
+    /// Returns \c Stmt::NoStmtClass if \c Name is not the name of a
+    /// concrete statement class.
+    Stmt::StmtClass getStmtClassByName(StringRef Name);
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
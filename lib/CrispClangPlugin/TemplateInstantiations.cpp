@@ -0,0 +1,124 @@
+// TemplateInstantiations.cpp ----------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/TemplateBase.h"
+#include "clang/AST/Type.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+
+#include "TemplateInstantiations.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    static bool isInstantiationKind(TemplateSpecializationKind Kind) {
+      return Kind == TSK_ImplicitInstantiation
+        || Kind == TSK_ExplicitInstantiationDeclaration
+        || Kind == TSK_ExplicitInstantiationDefinition;
+    }
+
+    /// Returns \c true if \c D itself (not its context) has been
+    /// instantiated from a template or from a member of a class
+    /// template.
+    static bool isInstantiatedEntity(const Decl *D) {
+      if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D))
+        return isInstantiationKind(RD->getTemplateSpecializationKind());
+      if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D))
+        return isInstantiationKind(FD->getTemplateSpecializationKind());
+      if (const VarDecl *VD = dyn_cast<VarDecl>(D))
+        return isInstantiationKind(VD->getTemplateSpecializationKind());
+      return false;
+    }
+
+    bool isInstantiated(const Decl *D) {
+      while (D && !isa<TranslationUnitDecl>(D)) {
+        if (isInstantiatedEntity(D)) return true;
+        const DeclContext *DC = D->getDeclContext();
+        D = DC ? Decl::castFromDeclContext(DC) : 0;
+      }
+      return false;
+    }
+
+    bool isTemplatePattern(const Decl *D) {
+      if (isa<TemplateDecl>(D)
+          || isa<ClassTemplatePartialSpecializationDecl>(D))
+        return true;
+      if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D))
+        if (FD->getDescribedFunctionTemplate()) return true;
+      if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D))
+        if (RD->getDescribedClassTemplate()) return true;
+      const DeclContext *DC = D->getDeclContext();
+      return DC && DC->isDependentContext();
+    }
+
+    static void appendTemplateArgs(std::string &Key,
+                                   const TemplateArgumentList &Args,
+                                   ASTContext &Context,
+                                   const PrintingPolicy &Policy) {
+      SmallVector<TemplateArgument, 4> Canonical;
+      for (unsigned I = 0; I < Args.size(); ++I)
+        Canonical.push_back(Context.getCanonicalTemplateArgument(Args.get(I)));
+      Key += TemplateSpecializationType::
+        PrintTemplateArgumentList(Canonical.data(), Canonical.size(),
+                                  Policy);
+    }
+
+    std::string getInstantiationKey(const NamedDecl *D, ASTContext &Context,
+                                    const PrintingPolicy &Policy) {
+      std::string Key;
+      // Unnamed contexts (e.g. linkage specifications) are skipped
+      for (const DeclContext *DC = D->getDeclContext(); DC;
+           DC = DC->getParent()) {
+        const Decl *Parent = Decl::castFromDeclContext(DC);
+        if (isa<TranslationUnitDecl>(Parent)) break;
+        if (const NamedDecl *ND = dyn_cast<NamedDecl>(Parent)) {
+          Key = getInstantiationKey(ND, Context, Policy) + "::";
+          break;
+        }
+      }
+
+      Key += D->getNameAsString();
+      if (const ClassTemplateSpecializationDecl *CTSD
+          = dyn_cast<ClassTemplateSpecializationDecl>(D))
+        appendTemplateArgs(Key, CTSD->getTemplateArgs(), Context, Policy);
+      if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D)) {
+        if (const TemplateArgumentList *Args
+            = FD->getTemplateSpecializationArgs())
+          appendTemplateArgs(Key, *Args, Context, Policy);
+        // Distinguishes overloads
+        Key += ' ';
+        Key += Context.getCanonicalType(FD->getType()).getAsString(Policy);
+      }
+      // Distinguishes locals with the same name in different scopes
+      if ( !D->isDefinedOutsideFunctionOrMethod()) {
+        Key += '@';
+        Key += llvm::utostr(D->getLocation().getRawEncoding());
+      }
+      return Key;
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
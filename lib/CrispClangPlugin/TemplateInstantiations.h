@@ -0,0 +1,63 @@
+// TemplateInstantiations.h ------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+/// \file
+/// \brief Classification of declarations into template patterns and
+/// template instantiations.
+
+#ifndef CRISPCLANGPLUGIN_TEMPLATEINSTANTIATIONS_H
+#define CRISPCLANGPLUGIN_TEMPLATEINSTANTIATIONS_H
+
+#include <string>
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "clang/AST/PrettyPrinter.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Returns \c true if \c D is, or is part of, an (implicit or
+    /// explicit) template instantiation. Explicit specializations are
+    /// written by the user, so they are not instantiations.
+    bool isInstantiated(const Decl *D);
+
+    /// Returns \c true if \c D is a class or function template
+    /// pattern, a partial specialization, or is part of one of them.
+    bool isTemplatePattern(const Decl *D);
+
+    /// Returns a string that identifies \c D among all the
+    /// declarations in the translation unit, built from the key of its
+    /// context, its name and its canonical template arguments (and
+    /// type, for functions). Function-local declarations are also
+    /// identified by their location, shared by all the instantiations
+    /// of a local. Instantiations with the same canonical arguments get
+    /// the same key, however the arguments were spelled.
+    std::string getInstantiationKey(const NamedDecl *D, ASTContext &Context,
+                                    const PrintingPolicy &Policy);
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
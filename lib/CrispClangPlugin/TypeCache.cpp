@@ -0,0 +1,76 @@
+// TypeCache.cpp -----------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string>
+
+#include "TypeCache.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    TypeCache::~TypeCache() {
+      // Atoms were registered when created, to protect them from
+      // atom garbage collection while cached.
+      for (llvm::DenseMap<void*, atom_t>::iterator
+             I = CanonicalTypeNames.begin(), E = CanonicalTypeNames.end();
+           I != E; ++I)
+        PL_unregister_atom(I->second);
+    }
+
+    QualType TypeCache::getCanonicalType(QualType T) {
+      void *&Entry = CanonicalTypes[T.getAsOpaquePtr()];
+      if ( !Entry) Entry = T.getCanonicalType().getAsOpaquePtr();
+      return QualType::getFromOpaquePtr(Entry);
+    }
+
+    QualType TypeCache::getDesugaredType(QualType T) {
+      void *&Entry = DesugaredTypes[T.getAsOpaquePtr()];
+      if ( !Entry) Entry = T.getDesugaredType(Context).getAsOpaquePtr();
+      return QualType::getFromOpaquePtr(Entry);
+    }
+
+    QualType TypeCache::getCanonicalPointee(QualType T) {
+      TypeMap::iterator I = CanonicalPointees.find(T.getAsOpaquePtr());
+      if (I != CanonicalPointees.end())
+        return QualType::getFromOpaquePtr(I->second);
+      QualType Result;
+      QualType Canonical = getCanonicalType(T);
+      const Type *CanonicalPtr = Canonical.getTypePtr();
+      if (const PointerType *PT = dyn_cast<PointerType>(CanonicalPtr))
+        Result = getCanonicalType(PT->getPointeeType());
+      CanonicalPointees[T.getAsOpaquePtr()] = Result.getAsOpaquePtr();
+      return Result;
+    }
+
+    atom_t TypeCache::getCanonicalTypeName(QualType T) {
+      QualType Canonical = getCanonicalType(T);
+      atom_t &Entry = CanonicalTypeNames[Canonical.getAsOpaquePtr()];
+      if ( !Entry) {
+        std::string Name = Canonical.getAsString(Policy);
+        Entry = PL_new_atom_nchars(Name.size(), Name.data());
+      }
+      return Entry;
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
@@ -0,0 +1,78 @@
+// TypeCache.h -------------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+/// \file
+/// \brief Per translation unit memoization of type computations.
+
+#ifndef CRISPCLANGPLUGIN_TYPECACHE_H
+#define CRISPCLANGPLUGIN_TYPECACHE_H
+
+#include <SWI-Prolog.h>
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/PrettyPrinter.h"
+#include "clang/AST/Type.h"
+#include "llvm/ADT/DenseMap.h"
+
+using namespace clang;
+
+namespace crisp {
+
+  namespace prolog {
+
+    /// Memoizes, per opaque \c QualType, the results of the type
+    /// computations most frequently used by rules. Pretty-printed
+    /// names are kept as (registered) Prolog atoms, so that both the
+    /// \c std::string and the atom are built only once per type.
+    class TypeCache {
+    public:
+      TypeCache(const ASTContext &Context, const PrintingPolicy &Policy)
+        : Context(Context), Policy(Policy) {
+      }
+
+      ~TypeCache();
+
+      QualType getCanonicalType(QualType T);
+
+      QualType getDesugaredType(QualType T);
+
+      /// Returns the canonical pointee type of \c T if the canonical
+      /// type of \c T is a pointer type, or a null \c QualType
+      /// otherwise.
+      QualType getCanonicalPointee(QualType T);
+
+      /// Returns an atom with the name of the canonical type of \c T.
+      atom_t getCanonicalTypeName(QualType T);
+
+    private:
+      typedef llvm::DenseMap<void*, void*> TypeMap;
+
+      const ASTContext &Context;
+      const PrintingPolicy &Policy;
+      TypeMap CanonicalTypes;
+      TypeMap DesugaredTypes;
+      TypeMap CanonicalPointees;
+      llvm::DenseMap<void*, atom_t> CanonicalTypeNames;
+    };
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
+
+#endif
@@ -33,6 +33,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetData.h"
 
+#include "crisp/NodeIdTable.h"
 #include "crisp/RunPrologEngine.h"
 #include "LLVMCompilationInfo.h"
 #include "LLVMPrologPredicateRegistration.h"
@@ -50,6 +51,12 @@ namespace crisp {
   cl::opt<bool> FlagInteractive("crisp-interactive",
                                 cl::desc("Enable interactive Prolog session"));
 
+  /// Command line flag to identify IR objects by dense integers
+  /// instead of raw pointers.
+  cl::opt<bool> FlagNodeIds("crisp-node-ids",
+                            cl::desc("Use integer identifiers for IR objects "
+                                     "in Prolog terms"));
+
   /// Command line option for Rules file
   cl::opt<std::string>
   RulesFileName("crisp-rules-file",
@@ -102,11 +109,12 @@ namespace crisp {
       if (Success) {
         DEBUG(dbgs() << "Processing module: " << M.getModuleIdentifier()
               << "\n");
+        getNodeIdTable().setEnabled(FlagNodeIds);
         (void) plAssertModule(&M);
 
         // Set some global data to be accessed from Prolog (var
         // CompilationInfo defined in CompilationInfo.h).
-        newLLVMCompilationInfo(*this);
+        newLLVMCompilationInfo(*this, M);
 
         // Main Prolog analysis
         Success = plRunModuleAnalysis();
@@ -117,6 +125,7 @@ namespace crisp {
 
         // Free global data
         deleteLLVMCompilationInfo();
+        getNodeIdTable().clear();
       }
     }
 
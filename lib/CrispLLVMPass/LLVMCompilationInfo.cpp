@@ -17,6 +17,8 @@
 // You should have received a copy of the GNU General Public License
 // along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
 
+#include "llvm/Support/InstIterator.h"
+
 #include "LLVMCompilationInfo.h"
 
 namespace crisp {
@@ -29,9 +31,9 @@ namespace crisp {
       return LLVMCompilationInfoSingleton;
     }
 
-    void newLLVMCompilationInfo(Pass& P) {
+    void newLLVMCompilationInfo(Pass& P, const Module &M) {
       if (LLVMCompilationInfoSingleton) delete LLVMCompilationInfoSingleton;
-      LLVMCompilationInfoSingleton = new LLVMCompilationInfo(P);
+      LLVMCompilationInfoSingleton = new LLVMCompilationInfo(P, M);
     }
 
     void deleteLLVMCompilationInfo() {
@@ -42,6 +44,18 @@ namespace crisp {
       // No dynamic memory to free.
     }
 
+    const Function *LLVMCompilationInfo::getFunctionOf(const void *Node) {
+      if ( !FunctionsBuilt) {
+        FunctionsBuilt = true;
+        for (llvm::Module::const_iterator F = Module.begin(), E = Module.end();
+             F != E; ++F)
+          for (const_inst_iterator I = inst_begin(F), IE = inst_end(F);
+               I != IE; ++I)
+            FunctionOf[&*I] = F;
+      }
+      return FunctionOf.lookup(Node);
+    }
+
   } // End namespace crisp::prolog
 
 } // End namespace crisp
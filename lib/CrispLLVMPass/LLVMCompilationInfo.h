@@ -26,6 +26,9 @@
 #include <list>
 
 #include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Function.h"
+#include "llvm/Module.h"
 #include "llvm/Pass.h"
 
 using namespace llvm;
@@ -43,17 +46,28 @@ namespace crisp {
 
       std::list<Location>& getLocations();
 
-      friend void newLLVMCompilationInfo(Pass &CI);
+      /// Returns the function containing the instruction \c Node, or
+      /// null if \c Node is not an instruction of the module. \c Node
+      /// is looked up by address, so it can be any node (e.g. a \c
+      /// Type). Instructions are indexed the first time it is called.
+      const Function *getFunctionOf(const void *Node);
+
+      friend void newLLVMCompilationInfo(Pass &CI, const Module &M);
       friend void deleteLLVMCompilationInfo();
 
     private:
-      LLVMCompilationInfo(Pass &P)
-        : Pass(P) {
+      LLVMCompilationInfo(Pass &P, const Module &M)
+        : Pass(P)
+        , Module(M)
+        , FunctionsBuilt(false) {
       }
 
       ~LLVMCompilationInfo();
 
       const Pass &Pass;
+      const Module &Module;
+      bool FunctionsBuilt;
+      llvm::DenseMap<const void*, const Function*> FunctionOf;
 
       // TODO: see if a more efficient data structure than a linked
       // list can be found for Locations. We need that pointers to
@@ -68,7 +82,7 @@ namespace crisp {
 
     LLVMCompilationInfo* getLLVMCompilationInfo();
 
-    void newLLVMCompilationInfo(Pass &P);
+    void newLLVMCompilationInfo(Pass &P, const Module &M);
 
     void deleteLLVMCompilationInfo();
 
@@ -23,10 +23,16 @@
 
 int plRegisterPredicates() {
   /* Automatically generated function registration. */
+#ifdef CRISP_PREDICATE_TABLES
+  if ( !plRegisterGeneratedPredicates()) return FALSE;
+#endif
 #include "crisp/PrologPredRegistrationMacros.h"
+#ifndef CRISP_PREDICATE_TABLES
 #include "LLVMDeclarations.inc"
+#endif
   /* Extra function (not a member function) */
-  pl_get_many(instruction, Function, const_inst_iterator, inst_begin, inst_end)
+  pl_get_many_reversible(instruction, Function, const_inst_iterator,
+                         inst_begin, inst_end)
 
   /* Manual function registration. */
 
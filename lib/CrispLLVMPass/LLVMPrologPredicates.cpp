@@ -31,6 +31,7 @@
 #include "llvm/Target/TargetData.h"
 #include "llvm/Type.h"
 
+#include "crisp/PredicateTable.h"
 #include "crisp/PrologPredBaseTemplates.h"
 #include "LLVMCompilationInfo.h"
 #include "LLVMPrologPredicates.h"
@@ -43,10 +44,35 @@ namespace crisp {
 
     // Automatically generated function definitions.
 
+#ifdef CRISP_PREDICATE_TABLES
+    namespace {
+#include "crisp/PrologPredTableDefinitionMacros.h"
+#include "LLVMDeclarations.inc"
+    }
+
+    static const PredicateDescriptor GeneratedPredicates[] = {
+#include "crisp/PrologPredTableMacros.h"
+#include "LLVMDeclarations.inc"
+      { 0, 0, 0, 0 }
+    };
+
+    int plRegisterGeneratedPredicates() {
+      return plRegisterPredicateTable(GeneratedPredicates);
+    }
+#endif
+
 #include "crisp/PrologPredDefinitionMacros.h"
+#ifndef CRISP_PREDICATE_TABLES
 #include "LLVMDeclarations.inc"
-    // Extra function (not a member function)
-    pl_get_many(instruction, Function, const_inst_iterator, inst_begin, inst_end)
+#endif
+    // Extra function (not a member function), reversible. The bound
+    // node may be of any kind, so it is looked up by address.
+    const void *inverse_Function_instruction(const void *Node) {
+      return getLLVMCompilationInfo()->getFunctionOf(Node);
+    }
+
+    pl_get_many_reversible(instruction, Function, const_inst_iterator,
+                           inst_begin, inst_end)
 
     // Manual function definition.
     const char* getSortName(unsigned OpCode) {
@@ -128,7 +154,7 @@ namespace crisp {
 
     foreign_t pl_isA_computed(term_t InstT, term_t SortT) {
       Instruction *I;
-      if ( !PL_get_pointer(InstT, (void **) &I))
+      if ( !plGetNode(InstT, (void **) &I))
         return PL_warning("isA/2: instantiation fault on first arg");
       return PL_unify_atom_chars(SortT, getSortName(I->getOpcode()));
     }
@@ -137,35 +163,35 @@ namespace crisp {
     // no sense
     foreign_t pl_getLocationFromStoreUser(term_t StoreT, term_t LocationT) {
       const StoreInst *I;
-      if ( !PL_get_pointer(StoreT, (void **) &I))
+      if ( !plGetNode(StoreT, (void **) &I))
         return PL_warning("getLocationFromStoreUser/2: "
                           "instantiation fault on first arg");
       const Pass &P = getLLVMCompilationInfo()->getPass();
       Location L = P.getAnalysis<AliasAnalysis>().getLocation(I);
       std::list<Location> &LS = getLLVMCompilationInfo()->getLocations();
       LS.push_back(L);
-      return PL_unify_pointer(LocationT, &LS.back());
+      return plUnifyNode(LocationT, &LS.back());
     }
 
     // FIXME: comparison (unification) with existing locations makes
     // no sense
     foreign_t pl_getLocationFromLoadUser(term_t LoadT, term_t LocationT) {
       const LoadInst *I;
-      if ( !PL_get_pointer(LoadT, (void **) &I))
+      if ( !plGetNode(LoadT, (void **) &I))
         return PL_warning("getLocationFromLoadUser/2: "
                           "instantiation fault on first arg");
       const Pass &P = getLLVMCompilationInfo()->getPass();
       Location L = P.getAnalysis<AliasAnalysis>().getLocation(I);
       std::list<Location> &LS = getLLVMCompilationInfo()->getLocations();
       LS.push_back(L);
-      return PL_unify_pointer(LocationT, &LS.back());
+      return plUnifyNode(LocationT, &LS.back());
     }
 
     // FIXME: comparison (unification) with existing locations makes
     // no sense
     foreign_t pl_createLocation(term_t ValueT, term_t LocationT) {
       const Value* V;
-      if ( !PL_get_pointer(ValueT, (void **) &V))
+      if ( !plGetNode(ValueT, (void **) &V))
         return PL_warning("createLocation/2: "
                           "instantiation fault on first arg");
       const Type* TypeOfV = V->getType();
@@ -184,15 +210,15 @@ namespace crisp {
       }
       std::list<Location> &LS = getLLVMCompilationInfo()->getLocations();
       LS.push_back(L);
-      return PL_unify_pointer(LocationT, &LS.back());
+      return plUnifyNode(LocationT, &LS.back());
     }
 
     foreign_t pl_aliasLessThanNoAlias(term_t LocationT1, term_t LocationT2) {
       Location *L1, *L2;
-      if ( !PL_get_pointer(LocationT1, (void **) &L1))
+      if ( !plGetNode(LocationT1, (void **) &L1))
         return PL_warning("aliasLessThanNoAlias/2: "
                           "instantiation fault on first arg");
-      if ( !PL_get_pointer(LocationT2, (void **) &L2))
+      if ( !plGetNode(LocationT2, (void **) &L2))
         return PL_warning("aliasLessThanNoAlias/2: "
                           "instantiation fault on second arg");
       const Pass &P = getLLVMCompilationInfo()->getPass();
@@ -203,10 +229,10 @@ namespace crisp {
 
     foreign_t pl_alias(term_t LocationT1, term_t LocationT2, term_t AliasT) {
       Location *L1, *L2;
-      if ( !PL_get_pointer(LocationT1, (void **) &L1))
+      if ( !plGetNode(LocationT1, (void **) &L1))
         return PL_warning("alias/2: "
                           "instantiation fault on first arg");
-      if ( !PL_get_pointer(LocationT2, (void **) &L2))
+      if ( !plGetNode(LocationT2, (void **) &L2))
         return PL_warning("alias/2: "
                           "instantiation fault on second arg");
       const Pass &P = getLLVMCompilationInfo()->getPass();
@@ -218,12 +244,15 @@ namespace crisp {
     foreign_t pl_getFunction(term_t ModuleT, term_t NameT,
                              term_t FunctionT) {
       const Module *M;
-      if ( !PL_get_pointer(ModuleT, (void **) &M))
+      if ( !plGetNode(ModuleT, (void **) &M))
         return PL_warning("getFunction/3: instantiation fault on first arg");
+      // Mangled names can also come as strings (see -string-results)
+      size_t Length;
       char *N;
-      if ( !PL_get_atom_chars(NameT, &N))
+      if ( !PL_get_nchars(NameT, &Length, &N,
+                          CVT_ATOM | CVT_STRING | CVT_LIST))
         return PL_warning("getFunction/3: instantiation fault on second arg");
-      return PL_unify_pointer(FunctionT, M->getFunction(StringRef(N)));
+      return plUnifyNode(FunctionT, M->getFunction(StringRef(N, Length)));
     }
 
     foreign_t pl_reportViolationLLVM(term_t RuleT, term_t MsgT,
@@ -247,7 +276,7 @@ namespace crisp {
         if ( !PL_get_arg(1, HeadT, ElemT)) return FALSE;
         if ( PL_unify_functor(HeadT, FunctionF)) {
           const Function *F;
-          if ( !PL_get_pointer(ElemT, (void **) &F)) return FALSE;
+          if ( !plGetNode(ElemT, (void **) &F)) return FALSE;
           Twine ElemString = Twine(": ") + Twine(F->getName()) + Twine("\n");
           errs() << ElemString;
           continue;
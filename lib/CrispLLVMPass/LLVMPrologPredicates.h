@@ -45,9 +45,15 @@ extern "C" {
       /* Automatically generated function declaration. */
 
 #include "crisp/PrologPredDeclarationMacros.h"
+#ifdef CRISP_PREDICATE_TABLES
+      /** Registers the predicates of the generated table. */
+      int plRegisterGeneratedPredicates(void);
+#else
 #include "LLVMDeclarations.inc"
+#endif
       /* Extra function (not a member function) */
-      pl_get_many(instruction, Function, const_inst_iterator, inst_begin, inst_end)
+      pl_get_many_reversible(instruction, Function, const_inst_iterator,
+                             inst_begin, inst_end)
 
       /* Manual function declaration. */
 
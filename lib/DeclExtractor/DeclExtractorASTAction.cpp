@@ -36,6 +36,7 @@
 #include "llvm/Support/FileSystem.h"
 
 #include "crisp/ClangPrologQueries.h"
+#include "crisp/DeclNameIndex.h"
 #include "crisp/RunPrologEngine.h"
 #include "DeclExtractorPrologPredicateRegistration.h"
 
@@ -104,11 +105,14 @@ namespace crisp {
       //             );
 
       // Traverse AST to visit declarations and statements
+      newDeclNameIndex();
       TraverseDecl(Context.getTranslationUnitDecl());
       DEBUG(dbgs() << "Traversing of the AST done!\n");
 
       // Main Prolog analysis
       Success = plRunTranslationUnitAnalysis(MainFileName);
+
+      deleteDeclNameIndex();
     }
 
     DEBUG(if (Success) dbgs() << "Translation unit analyzed.\n";
@@ -133,12 +137,14 @@ namespace crisp {
   bool DeclExtractorConsumer::VisitCXXMethodDecl(CXXMethodDecl *D) {
     std::string Sort("CXXMethodDecl");
     (void) plAssertDeclIsA(D, Sort);
+    getDeclNameIndex()->addDecl(D);
     return true;
   }
 
   bool DeclExtractorConsumer::VisitCXXRecordDecl(CXXRecordDecl *D) {
     std::string Sort("CXXRecordDecl");
     (void) plAssertDeclIsA(D, Sort);
+    getDeclNameIndex()->addDecl(D);
     return true;
   }
 
@@ -18,6 +18,7 @@
    along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "crisp/DeclNameIndexPredicates.h"
 #include "DeclExtractorPrologPredicates.h"
 #include "DeclExtractorPrologPredicateRegistration.h"
 
@@ -31,6 +32,10 @@ int plRegisterPredicates() {
                             (pl_function_t) &pl_CXXMethodDecl_isConstQualified,
                             0))
     return FALSE;
+  if ( !PL_register_foreign("declByName", 2,
+                            (pl_function_t) &pl_declByName,
+                            PL_FA_NONDETERMINISTIC))
+    return FALSE;
 
   return TRUE;
 }
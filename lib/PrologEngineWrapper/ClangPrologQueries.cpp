@@ -39,6 +39,31 @@ namespace crisp {
       return plAssertIsA((void *) Type, Sort);
     }
 
+    int plAssertInstantiationIsA(Decl *Decl, const std::string &Sort) {
+      return plAssertIsA((void *) Decl, Sort, "instantiationIsA");
+    }
+
+    int plNeedsTemplateInstantiations() {
+      term_t NeedsT = PL_new_term_ref();
+      if ( !PL_put_atom_chars(NeedsT, "needs_template_instantiations"))
+        return FALSE;
+      return PL_call(NeedsT, NULL);
+    }
+
+    int plRulesNeedFunctionBodies() {
+      term_t NeedsT = PL_new_term_ref();
+      if ( !PL_put_atom_chars(NeedsT, "rules_need_function_bodies"))
+        return TRUE;                      // Bodies needed, if unsure
+      return PL_call(NeedsT, NULL);
+    }
+
+    int plRulesNeedLLVMIR() {
+      term_t NeedsT = PL_new_term_ref();
+      if ( !PL_put_atom_chars(NeedsT, "rules_need_llvm_ir"))
+        return TRUE;                      // IR needed, if unsure
+      return PL_call(NeedsT, NULL);
+    }
+
     int plRunTranslationUnitAnalysis(const char* FileName) {
       int Success;
       term_t FileNameA = PL_new_term_ref();
@@ -0,0 +1,65 @@
+// ContextArena.cpp --------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "crisp/ContextArena.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    static ContextArena ContextArenaSingleton;
+
+    ContextArena &getContextArena() {
+      return ContextArenaSingleton;
+    }
+
+    ContextArena::ContextArena() {
+      for (unsigned I = 0; I < NumSizeClasses; ++I) FreeLists[I] = 0;
+    }
+
+    void *ContextArena::allocate(size_t Size) {
+      unsigned SizeClass = (Size + Granularity - 1) / Granularity;
+      if (SizeClass == 0) SizeClass = 1;
+      if (SizeClass <= NumSizeClasses && FreeLists[SizeClass - 1]) {
+        FreeBlock *Block = FreeLists[SizeClass - 1];
+        FreeLists[SizeClass - 1] = Block->Next;
+        return Block;
+      }
+      return Allocator.Allocate(SizeClass * Granularity, Granularity);
+    }
+
+    void ContextArena::deallocate(void *Block, size_t Size) {
+      if ( !Block) return;
+      unsigned SizeClass = (Size + Granularity - 1) / Granularity;
+      if (SizeClass == 0) SizeClass = 1;
+      if (SizeClass > NumSizeClasses) return;   // Kept until reset
+      FreeBlock *Freed = static_cast<FreeBlock*>(Block);
+      Freed->Next = FreeLists[SizeClass - 1];
+      FreeLists[SizeClass - 1] = Freed;
+    }
+
+    void ContextArena::reset() {
+      for (unsigned I = 0; I < NumSizeClasses; ++I) FreeLists[I] = 0;
+      Allocator.Reset();
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
@@ -0,0 +1,112 @@
+// DeclNameIndex.cpp -------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string>
+
+#include "crisp/DeclNameIndex.h"
+#include "crisp/DeclNameIndexPredicates.h"
+#include "crisp/PrologPredBaseTemplates.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    static DeclNameIndex *DeclNameIndexSingleton = 0;
+
+    DeclNameIndex* getDeclNameIndex() {
+      return DeclNameIndexSingleton;
+    }
+
+    void newDeclNameIndex() {
+      delete DeclNameIndexSingleton;
+      DeclNameIndexSingleton = new DeclNameIndex();
+    }
+
+    void deleteDeclNameIndex() {
+      delete DeclNameIndexSingleton;
+      DeclNameIndexSingleton = 0;
+    }
+
+    void DeclNameIndex::addDecl(const NamedDecl *D) {
+      // Plain identifiers (the vast majority of names) are looked up
+      // without building any string.
+      if (const IdentifierInfo *II = D->getIdentifier()) {
+        Names[II->getName()].push_back(D);
+      } else {
+        std::string Name = D->getNameAsString();
+        if (Name.empty()) return;             // Anonymous declaration
+        Names[Name].push_back(D);
+      }
+      Decls.push_back(D);
+    }
+
+    ArrayRef<const NamedDecl*> DeclNameIndex::lookup(StringRef Name) const {
+      llvm::StringMap<DeclList>::const_iterator I = Names.find(Name);
+      if (I == Names.end()) return ArrayRef<const NamedDecl*>();
+      return I->second;
+    }
+
+    ArrayRef<const NamedDecl*>
+    DeclNameIndex::lookupQualified(StringRef Name) {
+      // Qualified names are expensive to compute, so it's only done
+      // once per declaration, and only if some rule needs them.
+      for (; NumQualified < Decls.size(); ++NumQualified) {
+        const NamedDecl *D = Decls[NumQualified];
+        QualifiedNames[D->getQualifiedNameAsString()].push_back(D);
+      }
+      llvm::StringMap<DeclList>::const_iterator I = QualifiedNames.find(Name);
+      if (I == QualifiedNames.end()) return ArrayRef<const NamedDecl*>();
+      return I->second;
+    }
+
+    /// Gets the name in \c NameT, an atom or a string.
+    static inline bool getName(term_t NameT, StringRef &Name) {
+      size_t Length;
+      char *Chars;
+      if ( !PL_get_nchars(NameT, &Length, &Chars, CVT_ATOM | CVT_STRING))
+        return false;
+      Name = StringRef(Chars, Length);
+      return true;
+    }
+
+    foreign_t pl_declByName(term_t NameT, term_t DeclT, control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      StringRef Name;
+      if ( !getName(NameT, Name))
+        return pl_warning("declByName/2: instantiation fault on first arg");
+      if ( !getDeclNameIndex()) return FALSE;
+      return getManyFromArray<const NamedDecl>
+        (DeclT, getDeclNameIndex()->lookup(Name), Handle);
+    }
+
+    foreign_t pl_declByQualifiedName(term_t NameT, term_t DeclT,
+                                     control_t Handle) {
+      if (PL_foreign_control(Handle) == PL_PRUNED) return TRUE;
+      StringRef Name;
+      if ( !getName(NameT, Name))
+        return pl_warning("declByQualifiedName/2: "
+                          "instantiation fault on first arg");
+      if ( !getDeclNameIndex()) return FALSE;
+      return getManyFromArray<const NamedDecl>
+        (DeclT, getDeclNameIndex()->lookupQualified(Name), Handle);
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
@@ -0,0 +1,47 @@
+// NodeIdTable.cpp ---------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "crisp/NodeIdTable.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    static NodeIdTable NodeIdTableSingleton;
+
+    NodeIdTable &getNodeIdTable() {
+      return NodeIdTableSingleton;
+    }
+
+    uint32_t NodeIdTable::getId(const void *Node) {
+      if ( !Node) return 0;
+      std::pair<llvm::DenseMap<const void*, uint32_t>::iterator, bool> Ins
+        = Ids.insert(std::make_pair(Node, (uint32_t) Nodes.size()));
+      if (Ins.second) Nodes.push_back((void *) Node); // Cast removes const
+      return Ins.first->second;
+    }
+
+    void NodeIdTable::clear() {
+      Ids.clear();
+      Nodes.resize(1);
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
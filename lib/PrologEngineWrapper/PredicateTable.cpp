@@ -0,0 +1,52 @@
+// PredicateTable.cpp ------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "crisp/PredicateTable.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    int plRegisterPredicateTable(const PredicateDescriptor *Table) {
+      for (const PredicateDescriptor *D = Table; D->Name; ++D)
+        if ( !PL_register_foreign(D->Name, D->Arity, D->Function, D->Flags))
+          return FALSE;
+      return TRUE;
+    }
+
+    // Constant initialized, so it can be used by constructors of
+    // static objects in other translation units.
+    static const PredicateTableLink *LinkedTables = 0;
+
+    PredicateTableLink::PredicateTableLink(const PredicateDescriptor *Table)
+      : Table(Table)
+      , Next(LinkedTables) {
+      LinkedTables = this;
+    }
+
+    int plRegisterLinkedPredicateTables() {
+      for (const PredicateTableLink *L = LinkedTables; L; L = L->Next)
+        if ( !plRegisterPredicateTable(L->Table)) return FALSE;
+      return TRUE;
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
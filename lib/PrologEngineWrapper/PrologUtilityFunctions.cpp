@@ -22,6 +22,7 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include "crisp/NodeIdTable.h"
 #include "crisp/PrologUtilityFunctions.h"
 
 using namespace llvm;
@@ -30,15 +31,25 @@ namespace crisp {
 
   namespace prolog {
 
-    int plAssertIsA(void *Elem, const std::string &Sort) {
+    static bool StringResultsFlag = false;
+
+    void plSetStringResults(bool StringResults) {
+      StringResultsFlag = StringResults;
+    }
+
+    bool plStringResults() {
+      return StringResultsFlag;
+    }
+
+    int plAssertIsA(void *Elem, const std::string &Sort, const char *Pred) {
       int Success;
       term_t ElemT = PL_new_term_ref();
-      Success = PL_put_pointer(ElemT, Elem);
+      Success = plPutNode(ElemT, Elem);
       if ( !Success) return Success;
       term_t SortA = PL_new_term_ref();
       Success = PL_put_atom_chars(SortA, Sort.c_str());
       if ( !Success) return Success;
-      functor_t IsAF = PL_new_functor(PL_new_atom("isA"), 2);
+      functor_t IsAF = PL_new_functor(PL_new_atom(Pred), 2);
       term_t IsAT = PL_new_term_ref();
       Success = PL_cons_functor(IsAT, IsAF, ElemT, SortA);
       if ( !Success) return Success;
@@ -47,7 +58,7 @@ namespace crisp {
       Success = PL_cons_functor(AssertzT, AssertzF, IsAT);
       if ( !Success) return Success;
       Success = PL_call(AssertzT, NULL);
-      DEBUG(if ( !Success) dbgs() << "Error asserting 'isA "
+      DEBUG(if ( !Success) dbgs() << "Error asserting '" << Pred << " "
                                   << Sort << "' fact.\n");
       return Success;
     }
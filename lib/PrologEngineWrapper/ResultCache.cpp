@@ -0,0 +1,58 @@
+// ResultCache.cpp ---------------------------------------------------*- C++ -*-
+
+// Copyright (C) 2011, 2012 Guillem Marpons <gmarpons@babel.ls.fi.upm.es>
+//
+// This file is part of Crisp.
+//
+// Crisp is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Crisp is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Crisp.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "crisp/ResultCache.h"
+
+namespace crisp {
+
+  namespace prolog {
+
+    static ResultCache ResultCacheSingleton;
+
+    ResultCache &getResultCache() {
+      return ResultCacheSingleton;
+    }
+
+    bool ResultCache::lookup(const void *Node, const void *Getter,
+                             record_t &Result) const {
+      llvm::DenseMap<KeyType, record_t>::const_iterator I
+        = Results.find(KeyType(Node, Getter));
+      if (I == Results.end()) return false;
+      Result = I->second;
+      return true;
+    }
+
+    void ResultCache::insert(const void *Node, const void *Getter,
+                             term_t ResultT) {
+      record_t &Result = Results[KeyType(Node, Getter)];
+      if (Result) PL_erase(Result);
+      Result = ResultT ? PL_record(ResultT) : 0;
+    }
+
+    void ResultCache::reset() {
+      for (llvm::DenseMap<KeyType, record_t>::iterator I = Results.begin(),
+             E = Results.end(); I != E; ++I)
+        if (I->second) PL_erase(I->second);
+      Results.clear();
+    }
+
+  } // End namespace crisp::prolog
+
+} // End namespace crisp
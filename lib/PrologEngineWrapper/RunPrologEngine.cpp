@@ -27,6 +27,8 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include "crisp/ContextArena.h"
+#include "crisp/ResultCache.h"
 #include "crisp/RunPrologEngine.h"
 
 // Stringify environment variables
@@ -94,8 +96,14 @@ namespace crisp {
     }
 
     int plCleanUp(int Status) {
+      // Cached results refer to nodes of the current translation
+      // unit, and records can only be erased with a running engine.
+      getResultCache().reset();
       int Success = PL_cleanup(Status);
       free(BootFileAbsNameCStr);
+      // Contexts of pending nondeterministic calls are not needed
+      // once the engine is gone.
+      getContextArena().reset();
       DEBUG(if ( !Success) dbgs() << "Prolog engine clean up failed." << "\n");
       return Success;
     }
@@ -20,6 +20,19 @@
 :- multifile violation/3.
 :- multifile violation_candidate/2.
 :- multifile violation_llvm/3.
+:- multifile naming_convention/3.
+:- multifile rule_level/2.
+:- multifile body_local_rule/1.
+:- multifile body_violation/4.
+
+:- dynamic naming_convention/3.
+:- dynamic naming_violation_/2.
+:- dynamic naming_violations_computed/0.
+:- dynamic rule_level/2.
+:- dynamic instantiationIsA/2.
+:- dynamic body_local_rule/1.
+:- dynamic body_violation/4.
+:- dynamic reported_instantiation_violation/2.
 
 %% Argument is 'DebugFlag'.
 init_msg(true) :-
@@ -42,10 +55,21 @@ load_file(FileBaseName, RulesDir) :-
         ensure_loaded(rules(FileName)).
 
 runTranslationUnitAnalysis(TUMainFileName) :-
-        clangFactsFileName(TUMainFileName, ClangFactsFileName),
-        writeAllViolationCandidates(ClangFactsFileName),
+        ( rules_need_llvm_ir
+        -> clangFactsFileName(TUMainFileName, ClangFactsFileName),
+           writeAllViolationCandidates(ClangFactsFileName)
+        ; true
+        ),
         report_all_violations.
 
+%% True if some loaded rule is checked (also) on LLVM IR, by the
+%% Crisp LLVM pass. Otherwise neither IR nor candidates file are needed.
+rules_need_llvm_ir :-
+        ( predicate_property(violation_candidate(_, _), number_of_clauses(N))
+        ; predicate_property(violation_llvm(_, _, _), number_of_clauses(N))
+        ),
+        N > 0, !.
+
 clangFactsFileName(TUMainFileName, PrologName) :-
         file_base_name(TUMainFileName, CppName),
         file_name_extension(Base, _, CppName),
@@ -57,6 +81,262 @@ writeAllViolationCandidates(FileName) :-
                portray_clause(Stream, violation_candidate(Rule, Culprits))),
         close(Stream).
 
+%% naming_convention(Rule, Sort, Regex) facts, declared in rule files,
+%% state that the names of all declarations of sort Sort (as in isA/2,
+%% or an abstract class like 'ValueDecl') must match the POSIX
+%% extended regular expression Regex. E.g.:
+%%
+%%   naming_convention('Class names', 'CXXRecordDecl', '^[A-Z][A-Za-z0-9]*$').
+%%
+%%   violation('Class names', 'class name %0 is not in CamelCase',
+%%             ['NamedDecl'(Class, 'class %0 declared here')]) :-
+%%           naming_violation('Class names', Class).
+%%
+%% All conventions are checked together the first time
+%% naming_violation/2 is called, in a single pass over the named
+%% declarations of the translation unit.
+naming_violation(Rule, Decl) :-
+        ( naming_violations_computed
+        -> true
+        ; findall(naming_convention(R, S, X), naming_convention(R, S, X), Cs),
+          namingViolations(Cs, Vs),
+          forall(member(R-D, Vs), assertz(naming_violation_(R, D))),
+          assertz(naming_violations_computed)
+        ),
+        naming_violation_(Rule, Decl).
+
+%% rule_level(Rule, Level) facts, declared in rule files, state
+%% whether Rule is checked on template patterns (Level = pattern, the
+%% default for rules without a rule_level/2 fact) or on template
+%% instantiations (Level = instantiation). E.g.:
+%%
+%%   rule_level('Sizeof of template parameter', instantiation).
+%%
+%% Template patterns (and everything else written by the user) are
+%% isA/2 facts. Declarations in template instantiations are
+%% instantiationIsA/2 facts instead, and are only extracted if some
+%% rule is instantiation-level. Violations of instantiation-level
+%% rules are reported once per combination of instantiationKey/2
+%% values of their culprits.
+needs_template_instantiations :-
+        rule_level(_, instantiation), !.
+
+%% body_local_rule(Rule) facts, declared in rule files, state that
+%% violations of Rule only depend on the body of a function. Such rules
+%% are written as body_violation(Rule, Message, Function, Culprits)
+%% clauses, with Function bound on call. They are evaluated once per
+%% class of structurally identical bodies (see uniqueBody/1), and the
+%% violations found are reported for every function in the class, with
+%% culprits from the body mapped to their counterparts. E.g.:
+%%
+%%   body_local_rule('No goto').
+%%
+%%   body_violation('No goto', 'goto statement in %0', Function,
+%%                  ['NamedDecl'(Function, 'function %0 declared here')]) :-
+%%           'FunctionDecl::body'(Function, Body),
+%%           once(stmtOfClass(Body, 'GotoStmt', _)).
+violation(Rule, Message, Culprits) :-
+        body_local_violation(Rule, Message, Culprits).
+
+body_local_violation(Rule, Message, Culprits) :-
+        body_local_rule(Rule),
+        uniqueBody(Function),
+        body_violation(Rule, Message, Function, BodyCulprits),
+        bodyClone(Function, Clone),
+        maplist(clone_culprit(Function, Clone), BodyCulprits, Culprits).
+
+clone_culprit(Function, Clone, BodyCulprit, Culprit) :-
+        BodyCulprit =.. [Sort, Node|Args],
+        ( bodyCounterpart(Node, Function, Clone, CloneNode)
+        -> true
+        ; CloneNode = Node                % Not in the body
+        ),
+        Culprit =.. [Sort, CloneNode|Args].
+
+%% True if some loaded rule may inspect function bodies. Clauses of
+%% rule predicates are walked transitively, looking for goals that
+%% need statements. Goals that can't be known in advance (e.g. call/1
+%% on a variable, or a call to an undefined predicate) are assumed to
+%% need them. If false, the plugin can ask clang to skip function
+%% bodies when parsing.
+rules_need_function_bodies :-
+        body_local_rule(_), !.
+rules_need_function_bodies :-
+        rules_need_llvm_ir, !.
+rules_need_function_bodies :-
+        findall(Head, rule_entry(Head), Heads),
+        reaches_body_goal(Heads, []).
+
+rule_entry(violation(_, _, _)).
+rule_entry(violation_candidate(_, _)).
+rule_entry(violation_llvm(_, _, _)).
+
+%% Goals are walked in the module they are called from. Predicates
+%% imported from user modules are walked too: only system and library
+%% predicates are taken as body-free.
+reaches_body_goal([QGoal|_], _) :-
+        strip_module(QGoal, _, Goal),
+        body_goal(Goal), !.
+reaches_body_goal([QGoal|Goals], Visited) :-
+        strip_module(QGoal, Module, Goal),
+        definition_module(Module:Goal, DefModule),
+        functor(Goal, Name, Arity),
+        ( memberchk(DefModule:Name/Arity, Visited)
+        ; Goal = body_local_violation(_, _, _) % Checked apart
+        ; predicate_property(Module:Goal, built_in)
+        ; library_module(DefModule)
+        ; predicate_property(Module:Goal, foreign) % Classified by body_goal/1
+        ; generated_goal(Goal)
+        ), !,
+        reaches_body_goal(Goals, Visited).
+reaches_body_goal([QGoal|_], _) :-
+        strip_module(QGoal, Module, Goal),
+        \+ predicate_property(Module:Goal, defined), !. % May need bodies
+reaches_body_goal([QGoal|Goals], Visited) :-
+        strip_module(QGoal, Module, Goal),
+        definition_module(Module:Goal, DefModule),
+        functor(Goal, Name, Arity),
+        functor(Head, Name, Arity),
+        findall(DefModule:SubGoal,
+                ( clause(DefModule:Head, Body), subgoal(Body, SubGoal) ),
+                SubGoals),
+        append(SubGoals, Goals, Pending),
+        reaches_body_goal(Pending, [DefModule:Name/Arity|Visited]).
+
+definition_module(Module:Goal, DefModule) :-
+        (  predicate_property(Module:Goal, imported_from(DefModule))
+        -> true
+        ;  DefModule = Module
+        ).
+
+library_module(Module) :-
+        module_property(Module, class(Class)),
+        memberchk(Class, [system, library]).
+
+subgoal(Goal, Goal) :-
+        var(Goal), !.
+subgoal((A, B), Goal) :- !,
+        ( subgoal(A, Goal) ; subgoal(B, Goal) ).
+subgoal((A ; B), Goal) :- !,
+        ( subgoal(A, Goal) ; subgoal(B, Goal) ).
+subgoal((A -> B), Goal) :- !,
+        ( subgoal(A, Goal) ; subgoal(B, Goal) ).
+subgoal(\+ A, Goal) :- !,
+        subgoal(A, Goal).
+subgoal(Module:A, Module:Goal) :- !,
+        subgoal(A, Goal).
+subgoal(Meta, Goal) :-
+        predicate_property(Meta, meta_predicate(Spec)), !,
+        ( Goal = Meta
+        ; arg(I, Spec, ArgSpec),
+          integer(ArgSpec),
+          arg(I, Meta, Closure),
+          extend_closure(Closure, ArgSpec, Arg),
+          subgoal(Arg, Goal)
+        ).
+subgoal(Goal, Goal).
+
+extend_closure(Closure, _, _) :-
+        var(Closure), !.
+extend_closure(Module:Closure, N, Module:Goal) :- !,
+        extend_closure(Closure, N, Goal).
+extend_closure(Closure, 0, Closure) :- !.
+extend_closure(Closure, N, Goal) :-
+        Closure =.. List,
+        length(Extra, N),
+        append(List, Extra, GoalList),
+        Goal =.. GoalList.
+
+%% Generated getters and property checkers are named 'Class::method'.
+%% They are classified by body_goal/1, even if they aren't registered.
+generated_goal(Goal) :-
+        functor(Goal, Name, _),
+        sub_atom(Name, _, _, _, '::'), !.
+
+body_goal(Goal) :-
+        var(Goal), !.
+body_goal(Goal) :-
+        functor(Goal, Name, Arity),
+        ( body_predicate(Name/Arity)
+        -> true
+        ; sub_atom(Name, Before, 2, After, '::'),
+          sub_atom(Name, 0, Before, _, Class),
+          sub_atom(Name, _, After, 0, Method),
+          ( body_method(Class, Method)
+          ; member(Suffix, ['Stmt', 'Expr', 'Operator', 'Literal',
+                            'Cleanups']),
+            atom_concat(_, Suffix, Class)
+          )
+        -> true
+        ).
+
+%% Accessors of bodies, and of definitions of functions: the latter
+%% only exist if bodies are parsed.
+body_method(_, Method) :-
+        ( sub_atom(Method, _, _, _, body)
+        ; sub_atom(Method, _, _, _, 'Body')
+        ), !.
+body_method(Class, Method) :-
+        memberchk(Class, ['FunctionDecl', 'CXXMethodDecl',
+                          'CXXConstructorDecl', 'CXXDestructorDecl',
+                          'CXXConversionDecl', 'FunctionTemplateDecl']),
+        ( sub_atom(Method, _, _, _, efinition)
+        ; sub_atom(Method, _, _, _, efined)
+        ), !.
+
+body_predicate(descendant/2).
+body_predicate(stmtOfClass/3).
+body_predicate(parent/2).
+body_predicate(ancestor/2).
+body_predicate(enclosingDecl/2).
+body_predicate(calls/3).
+body_predicate(reaches/2).
+body_predicate(reaches/3).
+body_predicate(cfgBlock/2).
+body_predicate(cfgEntry/2).
+body_predicate(cfgExit/2).
+body_predicate(cfgSucc/2).
+body_predicate(cfgElement/2).
+body_predicate(dominates/2).
+body_predicate(cfgReachable/2).
+body_predicate(nodeInRange/4).
+body_predicate(uniqueBody/1).
+body_predicate(bodyClone/2).
+body_predicate(bodyCounterpart/4).
+body_predicate('FunctionDecl::has_body'/1).
+body_predicate('FunctionDecl::is_defined'/1).
+body_predicate('FunctionDecl::is_thisDeclarationADefinition'/1).
+body_predicate('FunctionDecl::definition'/2).
+body_predicate('CXXMethodDecl::has_inlineBody'/1).
+%% In reverse mode it enumerates local declarations, too. The mode of
+%% a call isn't known in advance.
+body_predicate('Decl::declContext'/2).
+
 report_all_violations :-
+        forall(( violation(Rule, Message, Culprits),
+                 \+ rule_level(Rule, instantiation)
+               ),
+               report_violation(Rule, Message, Culprits)),
+        forall(rule_level(Rule, instantiation),
+               report_instantiation_violations(Rule)).
+
+report_instantiation_violations(Rule) :-
         forall(violation(Rule, Message, Culprits),
-               report_violation(Rule, Message, Culprits)).
+               ( culprit_keys(Culprits, Keys),
+                 \+ reported_instantiation_violation(Rule, Keys)
+               -> assertz(reported_instantiation_violation(Rule, Keys)),
+                  report_violation(Rule, Message, Culprits)
+               ; true
+               )).
+
+%% Only declarations have instantiation keys. Other culprits (e.g.
+%% statements) are their own keys.
+culprit_keys([], []).
+culprit_keys([Culprit|Culprits], [Key|Keys]) :-
+        arg(1, Culprit, Node),
+        (  once(( isA(Node, _) ; instantiationIsA(Node, _) )),
+           instantiationKey(Node, Key0)
+        -> Key = Key0
+        ;  Key = Node
+        ),
+        culprit_keys(Culprits, Keys).
@@ -50,21 +50,45 @@ clangFactsFileName(TUMainFileName, PrologName) :-
         file_name_extension(Base, _, CppName),
         file_name_extension(Base, inc, PrologName).
 
+%% Declarations are grouped by argument class. Every group is guarded
+%% by a preprocessor condition that assigns the class to a shard, so
+%% that definitions can be compiled in CRISP_DECL_SHARDS translation
+%% units, each one with a different CRISP_DECL_SHARD. When the latter
+%% is not defined, all groups are included.
 writeAllInterestingDecls(FileName) :-
+        findall(ArgType-Decl,
+                ( interestingDecl(Decl), declArgType(Decl, ArgType) ),
+                Pairs),
+        keysort(Pairs, SortedPairs),
+        group_pairs_by_key(SortedPairs, Groups),
         open(FileName, write, Stream),
-        forall(interestingDecl(Decl),
-               (write_term(Stream, Decl, [quoted(false)]), nl(Stream))),
+        forall(member(ArgType-Decls, Groups),
+               writeDeclGroup(Stream, ArgType, Decls)),
         close(Stream).
 
+writeDeclGroup(Stream, ArgType, Decls) :-
+        term_hash(ArgType, Hash),
+        format(Stream, '#if !defined(CRISP_DECL_SHARD) || \c
+                        CRISP_DECL_SHARD == ~d % CRISP_DECL_SHARDS~n',
+               [Hash]),
+        forall(member(Decl, Decls),
+               (write_term(Stream, Decl, [quoted(false)]), nl(Stream))),
+        format(Stream, '#endif~n', []).
+
+declArgType(pl_check_property(_Verb, _Name, ArgType, _CXXName), ArgType) :-
+        !.
+declArgType(Decl, ArgType) :-
+        arg(2, Decl, ArgType).
+
 
 %%
 %%
 %%
 
 top_class(Class) :-
-        isA(Class, 'CXXRecordDecl'),
-        'NamedDecl::nameAsString'(Class, Name),
-        top_class_name(Name).
+        top_class_name(Name),
+        declByName(Name, Class),
+        isA(Class, 'CXXRecordDecl').
 
 top_class_heir(Class) :-
         top_class(Class).
@@ -169,11 +193,22 @@ qualifiedMemberName(Class, Member, QualifiedMember) :-
         atom_concat(Class, '::', Aux),
         atom_concat(Aux, Member, QualifiedMember).
 
-interestingDecl(pl_get_one(Name, ArgType, ResTypeName, CXXName)) :-
+%% Getters that build a new string (or are otherwise expensive) are
+%% memoized.
+cachedGetter(_MethodName, 'std::string').
+cachedGetter(getCanonicalType, _ResTypeName).
+
+getOneAccessor(Name, ArgType, ResTypeName, CXXName, MethodName) :-
         top_class_heir(Class),
         candidateMethod(Class, Method),
         'NamedDecl::nameAsString'(Method, MethodName),
         \+ isOperatorName(MethodName),
+        interestingResultTypeName(Method, ResTypeName),
+        'NamedDecl::nameAsString'(Class, ArgType),
+        remove_get(MethodName, Name),
+        qualifiedMemberName(ArgType, MethodName, CXXName).
+
+interestingResultTypeName(Method, ResTypeName) :-
         'FunctionDecl::resultType'(Method, ResType),
         'QualType::asString'(ResType, ResTypeNameAux),
                                 % remove "class " and "struct " from type name
@@ -183,10 +218,69 @@ interestingDecl(pl_get_one(Name, ArgType, ResTypeName, CXXName)) :-
         \+ sub_atom(ResTypeName, _, _, _, iterator),
         'QualType::canonicalType'(ResType, CanonicalResType),
         'QualType::typePtr'(CanonicalResType, ResTypePtr),
-        isInterestingResultType(ResTypePtr, ResTypeName),
-        'NamedDecl::nameAsString'(Class, ArgType),
+        isInterestingResultType(ResTypePtr, ResTypeName).
+
+%% Accessors with a single integral parameter, a position (e.g.
+%% FunctionDecl::getParamDecl(unsigned)).
+indexedMethod(Class, Method, IndexTypeName) :-
+        'CXXRecordDecl::method'(Class, Method),
+        'CXXMethodDecl::constQualified'(Method),
+        \+ 'CXXMethodDecl::is_static'(Method),
+        'Decl::access'(Method, public),
+        'FunctionDecl::numParams'(Method, 1),
+        'CXXMethodDecl::size_overridden_methods'(Method, 0),
+        'FunctionDecl::param'(Method, Param),
+        'ValueDecl::type'(Param, IndexType),
+        'QualType::canonicalType'(IndexType, CanonicalIndexType),
+        'QualType::asString'(CanonicalIndexType, IndexTypeName),
+        indexTypeName(IndexTypeName).
+
+indexTypeName('unsigned int').
+indexTypeName(int).
+
+%% The size method of getParamDecl(unsigned) is getNumParams().
+indexSizeMethod(Class, Name, SizeMethod, SizeType) :-
+        sizeMethod(Class, Name, SizeMethod, SizeType),
+        !.
+indexSizeMethod(Class, Name, SizeMethod, SizeType) :-
+        atom_concat(Base, 'Decl', Name),
+        sizeMethod(Class, Base, SizeMethod, SizeType).
+
+%% Getters of one-shot text, rarely compared with constants in rules,
+%% that can be returned as strings instead of atoms (see the
+%% -string-results plugin argument). They are memoized, too.
+textGetter('QualType', asString).
+
+%% Relations that can also be called with the first argument free. An
+%% inverse_ArgType_Name function must be defined by hand (and declared
+%% in RelationInverses.h, in the Clang plugin).
+reversibleRelation('CXXRecordDecl', method).
+reversibleRelation('Decl', declContext).
+reversibleRelation('Stmt', child).
+
+interestingDecl(Decl) :-
+        getOneAccessor(Name, ArgType, ResTypeName, CXXName, MethodName),
+        (  reversibleRelation(ArgType, Name)
+        -> Decl = pl_get_one_reversible(Name, ArgType, ResTypeName, CXXName)
+        ;  textGetter(ArgType, Name)
+        -> Decl = pl_get_one_text(Name, ArgType, ResTypeName, CXXName)
+        ;  cachedGetter(MethodName, ResTypeName)
+        -> Decl = pl_get_one_cached(Name, ArgType, ResTypeName, CXXName)
+        ;  Decl = pl_get_one(Name, ArgType, ResTypeName, CXXName)
+        ).
+interestingDecl(pl_get_one_n(Name, ArgType, ResTypeName, IndexTypeName,
+                             CXXName, SizeType, CXXSizeName)) :-
+        top_class_heir(Class),
+        indexedMethod(Class, Method, IndexTypeName),
+        'NamedDecl::nameAsString'(Method, MethodName),
+        \+ isOperatorName(MethodName),
+        interestingResultTypeName(Method, ResTypeName),
         remove_get(MethodName, Name),
-        qualifiedMemberName(ArgType, MethodName, CXXName).
+        indexSizeMethod(Class, Name, SizeMethod, SizeType),
+        'NamedDecl::nameAsString'(Class, ArgType),
+        qualifiedMemberName(ArgType, MethodName, CXXName),
+        'NamedDecl::nameAsString'(SizeMethod, SizeMethodName),
+        qualifiedMemberName(ArgType, SizeMethodName, CXXSizeName).
 interestingDecl(pl_check_property(Verb, Name, ArgType, CXXName)) :-
         top_class_heir(Class),
         candidateMethod(Class, Method),
@@ -196,8 +290,59 @@ interestingDecl(pl_check_property(Verb, Name, ArgType, CXXName)) :-
         'NamedDecl::nameAsString'(Method, MethodName),
         remove_is_or_has(MethodName, (Verb, Name)),
         qualifiedMemberName(ArgType, MethodName, CXXName).
+interestingDecl(pl_get_many_reversible(Name, ArgType, ItType,
+                                       ItBegin, ItEnd)) :-
+        top_class_heir(Class),
+        iteratorRange(Class, Name, ArgType, ItType, ItBegin, ItEnd),
+        reversibleRelation(ArgType, Name).
+%% Ranges with a size method get a _count predicate that doesn't
+%% traverse them.
+interestingDecl(pl_get_many_sized(Name, ArgType, ItType, ItBegin, ItEnd,
+                                  SizeType, CXXSizeName)) :-
+        top_class_heir(Class),
+        iteratorRange(Class, Name, ArgType, ItType, ItBegin, ItEnd),
+        \+ reversibleRelation(ArgType, Name),
+        sizeMethod(Class, Name, SizeMethod, SizeType),
+        'NamedDecl::nameAsString'(SizeMethod, SizeMethodName),
+        qualifiedMemberName(ArgType, SizeMethodName, CXXSizeName).
 interestingDecl(pl_get_many(Name, ArgType, ItType, ItBegin, ItEnd)) :-
         top_class_heir(Class),
+        iteratorRange(Class, Name, ArgType, ItType, ItBegin, ItEnd),
+        \+ reversibleRelation(ArgType, Name),
+        \+ sizeMethod(Class, Name, _, _).
+
+toUpperFirst(Atom, ToUpperFirst) :-
+        atom_codes(Atom, [L|Tail]),
+        to_upper(L, U),
+        atom_codes(ToUpperFirst, [U|Tail]).
+
+%% Names used in Clang and LLVM for the method returning the length
+%% of range Name.
+sizeMethodName(Name, SizeMethodName) :-
+        atom_concat(Name, '_size', SizeMethodName).
+sizeMethodName(Name, SizeMethodName) :-
+        atom_concat('size_', Name, SizeMethodName).
+sizeMethodName(Name, SizeMethodName) :-
+        toUpperFirst(Name, UpperName),
+        atom_concat(getNum, UpperName, SizeMethodName).
+sizeMethodName(Name, SizeMethodName) :-
+        toUpperFirst(Name, UpperName),
+        atomic_list_concat([getNum, UpperName, s], SizeMethodName).
+
+sizeMethod(Class, Name, SizeMethod, SizeTypeName) :-
+        sizeMethodName(Name, SizeMethodName),
+        candidateMethod(Class, SizeMethod),
+        'NamedDecl::nameAsString'(SizeMethod, SizeMethodName),
+        'FunctionDecl::resultType'(SizeMethod, ResType),
+        'QualType::canonicalType'(ResType, CanonicalResType),
+        'QualType::typePtr'(CanonicalResType, ResTypePtr),
+        'Type::is_builtinType'(ResTypePtr),
+        'QualType::asString'(CanonicalResType, SizeTypeName),
+        SizeTypeName \= 'void',
+        SizeTypeName \= '_Bool',
+        !.
+
+iteratorRange(Class, Name, ArgType, ItType, ItBegin, ItEnd) :-
         candidateMethod(Class, BeginMethod),
         'NamedDecl::nameAsString'(BeginMethod, BeginMethodName),
         sub_atom(BeginMethodName, Before, 5, After, begin),
@@ -59,25 +59,14 @@
 %%
 %% Executable formalization in Prolog:
 
-'child+'(Stmt, DirectChild) :-
-        'Stmt::child'(Stmt, DirectChild).
-'child+'(Stmt, IndirectChild) :-
-        'Stmt::child'(Stmt, DirectChild),
-        'child+'(DirectChild, IndirectChild).
+'child+'(Stmt, Descendant) :-
+        descendant(Stmt, Descendant).
 
 calls_to_this(Caller, Callee) :-
-        'Decl::body'(Caller, Body),
-        'child+'(Body, CallExpr),
-        'Stmt::stmtClassName'(CallExpr, 'CXXMemberCallExpr'),
-        'CXXMemberCallExpr::implicitObjectArgument'(CallExpr, MemberExpr),
-        'Stmt::stmtClassName'(MemberExpr, 'CXXThisExpr'),
-        'CallExpr::directCallee'(CallExpr, Callee).
+        calls(Caller, Callee, this).
 
 'calls_to_this+'(Caller, Callee) :-
-        calls_to_this(Caller, Callee).
-'calls_to_this+'(Caller, IndirectCallee) :-
-        calls_to_this(Caller, DirectCallee),
-        'calls_to_this+'(DirectCallee, IndirectCallee).
+        reaches(Caller, Callee, this).
 
 violation('HICPP 3.3.13',
           'ctor/dtor %0 calls (maybe indirectly) virtual method %1',
@@ -142,11 +131,7 @@ violation_candidate('HICPP 3.4.2', [MethodRepr]) :-
         'QualType::canonicalType'(MethodType, CanonicalMethodType),
         isConstFunctionProtoType(CanonicalMethodType),
         'FunctionType::resultType'(CanonicalMethodType, ResultType),
-        'QualType::canonicalType'(ResultType, CanonicalResultType),
-        isA(CanonicalResultType, 'PointerType'),
-        'QualType::typePtr'(CanonicalResultType, ResultTypePtr),
-        'PointerType::pointeeType'(ResultTypePtr, PointeeType),
-        'QualType::canonicalType'(PointeeType, CanonicalPointeeType),
+        canonicalPointee(ResultType, CanonicalPointeeType),
         \+ 'QualType::is_constQualified'(CanonicalPointeeType),
 
                                 % This part should be generated by